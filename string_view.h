@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdio.h>
     
 #define STRING_VIEW_FORMAT "%.*s"
 #define STRING_VIEW_ARG(sv) (sv).count, (sv).data
@@ -215,7 +216,8 @@ string_view_t string_view_substr(string_view_t sv, size_t start, size_t count);
  * * Returns 0 if `sv1` is equal to `sv2`.
  * * Returns a positive value if `sv1` is greater than `sv2`.
  *
- * The comparison is based on the numerical values of the corresponding characters in the two string views.
+ * The characters are compared as unsigned bytes, embedded null characters included, and a string view
+ * that is a prefix of the other one orders first.
  *
  * @param sv1 The first string view.
  * @param sv2 The second string view.
@@ -259,6 +261,19 @@ bool string_view_starts_with(string_view_t sv, string_view_t prefix);
  */
 bool string_view_ends_with(string_view_t sv, string_view_t suffix); 
 
+/**
+ * @brief Sorts an array of string views in lexicographic order.
+ *
+ * This function sorts the views in the order of `string_view_compare` with a multikey quicksort that
+ * partitions on 8 bytes at a time. The next 8 bytes of every key are cached next to the view as a
+ * big-endian integer, so most comparisons are a single integer compare that does not touch the string
+ * data. The sort is not stable.
+ *
+ * @param views The string views to sort.
+ * @param count The number of string views.
+ */
+void string_view_sort(string_view_t* views, size_t count);
+
 /**
  * @brief Finds the first occurrence of a character in a string view.
  *
@@ -273,6 +288,44 @@ bool string_view_ends_with(string_view_t sv, string_view_t suffix);
  */
 size_t string_view_find_char(string_view_t sv, char c, size_t start);
 
+/**
+ * @brief Finds the last occurrence of a character in a string view.
+ *
+ * This function searches backwards for the last occurrence of the character `c` within the string view `sv`
+ * that is located at or before index `start`. Passing `STRING_VIEW_NPOS` as `start` searches the whole view.
+ * If the character is found, its index is returned; otherwise, `STRING_VIEW_NPOS` is returned.
+ *
+ * @param sv The string view to search.
+ * @param c The character to find.
+ * @param start The index where the backward search begins.
+ * @return The index of the last occurrence of `c`, or `STRING_VIEW_NPOS` if not found.
+ */
+size_t string_view_rfind_char(string_view_t sv, char c, size_t start);
+
+/**
+ * @brief Counts the occurrences of a character in a string view.
+ *
+ * This function returns how many times the character `c` appears inside the string view `sv`.
+ *
+ * @param sv The string view to scan.
+ * @param c The character to count.
+ * @return The number of occurrences of `c`.
+ */
+size_t string_view_count_char(string_view_t sv, char c);
+
+/**
+ * @brief Counts the lines of a string view.
+ *
+ * This function counts the lines the same way as the line iterator: every `'\n'` ends a line, and a
+ * last line without a trailing newline is counted as well, so an empty view has no line. The newlines
+ * are counted with the same vectorized kernel as `string_view_count_char`, which makes the result
+ * suitable for sizing arrays before splitting.
+ *
+ * @param sv The string view to scan.
+ * @return The number of lines.
+ */
+size_t string_view_count_lines(string_view_t sv);
+
 /**
  * @brief Finds the first occurrence of a substring within a string view.
  *
@@ -287,201 +340,7985 @@ size_t string_view_find_char(string_view_t sv, char c, size_t start);
  */
 size_t string_view_find_substring(string_view_t haystack, string_view_t needle, size_t start);
 
-#if defined(__STDC__) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+/**
+ * Algorithms that a precompiled searcher can select for its needle.
+ */
+typedef enum {
+    STRING_VIEW_SEARCH_EMPTY = 0,   /**< Empty needle, matches at every position. */
+    STRING_VIEW_SEARCH_CHAR,        /**< Single character needle, uses the vectorized character search. */
+    STRING_VIEW_SEARCH_FILTER,      /**< Short needle, SIMD filtering on the first and last byte. */
+    STRING_VIEW_SEARCH_TWO_WAY      /**< Long needle, Two-Way with a Horspool bad character table. */
+} string_view_search_algorithm_t;
 
 /**
- * @brief Checks if a string view contains a specified element.
+ * A substring searcher compiled once for a specific needle.
  *
- * This macro provides a generic way to check if a string view contains either a character or a substring.
- * The appropriate function (`string_view_find_char` or `string_view_find_substring`) is selected based on the type of the `needle` argument.
+ * The searcher keeps a reference to the needle, so the needle data must outlive it.
+ * Matching is binary-safe: embedded null characters are compared like any other byte.
+ */
+typedef struct {
+    string_view_t needle;
+    string_view_search_algorithm_t algorithm;
+    size_t suffix;
+    size_t period;
+    bool periodic;
+    size_t shift[256];
+} string_view_searcher_t;
+
+/**
+ * @brief Compiles a substring searcher for the given needle.
  *
- * @param haystack The string view to search.
- * @param needle The element to find (can be a character or a substring).
- * @return `true` if the element is found within the haystack, `false` otherwise.
+ * This function analyses the needle once and selects the most suitable search algorithm
+ * for its length: single character needles use the vectorized character search, short needles
+ * use SIMD filtering on their first and last byte and long needles use the Two-Way algorithm,
+ * which runs in linear time and skips ahead with a Horspool bad character table.
+ *
+ * @param needle The substring to search for. It must outlive the searcher.
+ * @return A new searcher object.
  */
-#define string_view_contains(haystack, needle)                          \
-    (_Generic((needle),                                                 \
-              int : string_view_find_char,                              \
-              string_view_t : string_view_find_substring)(sv, needle, 0) != STRING_VIEW_NPOS)
-#else
+string_view_searcher_t new_string_view_searcher(string_view_t needle);
 
 /**
- * @brief Checks if a string view contains a specific character.
+ * @brief Finds the first occurrence of the searcher needle in a string view.
  *
- * This macro is a convenience wrapper around `string_view_find_char` to determine if a character exists within a string view.
- * It returns `true` if the character is found, otherwise `false`.
+ * This function searches for the first occurrence of the compiled needle within `haystack`,
+ * starting at index `start`.
  *
+ * @param searcher The compiled searcher.
  * @param haystack The string view to search.
- * @param needle The character to find.
- * @return `true` if the character is found, `false` otherwise.
+ * @param start The starting index of the search.
+ * @return The index of the first occurrence, or `STRING_VIEW_NPOS` if not found.
  */
-#define string_view_contains_char(haystack, needle) \
-    (string_view_find_char(haystack, needle, 0) != STRING_VIEW_NPOS)
+size_t string_view_searcher_find(const string_view_searcher_t* searcher, string_view_t haystack, size_t start);
 
 /**
- * @brief Checks if a string view contains a specific substring.
+ * @brief Finds the next occurrence of the searcher needle after a previous match.
  *
- * This macro is a convenience wrapper around `string_view_find_substring` to determine if a substring exists within a string view.
- * It returns `true` if the substring is found, otherwise `false`.
+ * This function searches for an occurrence of the compiled needle that starts after index `previous`.
+ * Overlapping occurrences are reported. Passing `STRING_VIEW_NPOS` as `previous` starts the search
+ * at the beginning of the haystack, which makes iterating over all the matches straightforward.
  *
+ * @param searcher The compiled searcher.
  * @param haystack The string view to search.
- * @param needle The substring to find.
- * @return `true` if the substring is found, `false` otherwise.
+ * @param previous The index of the previous match, or `STRING_VIEW_NPOS`.
+ * @return The index of the next occurrence, or `STRING_VIEW_NPOS` if not found.
  */
-#define string_view_contains_substring(haystack, needle) \
-    (string_view_find_substring(haystack, needle, 0) != STRING_VIEW_NPOS)
+size_t string_view_searcher_find_next(const string_view_searcher_t* searcher, string_view_t haystack, size_t previous);
 
-#endif
+/**
+ * @brief Finds all the occurrences of the searcher needle in a string view.
+ *
+ * This function scans `haystack` once and stores the indices of all the (possibly overlapping)
+ * occurrences of the needle in `positions`, in increasing order. At most `capacity` indices are stored,
+ * but the returned value is always the total number of occurrences.
+ *
+ * @param searcher The compiled searcher.
+ * @param haystack The string view to search.
+ * @param positions The output array for the match indices (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `positions`.
+ * @return The total number of occurrences.
+ */
+size_t string_view_searcher_find_all(const string_view_searcher_t* searcher, string_view_t haystack,
+                                     size_t* positions, size_t capacity);
 
-#endif
+/**
+ * A match reported by a multi-pattern search.
+ */
+typedef struct {
+    size_t pattern; /**< Index of the pattern in the array used to build the automaton. */
+    size_t offset;  /**< Index of the first character of the match in the haystack. */
+} string_view_match_t;
 
-#ifdef STRING_VIEW_IMPLEMENTATION
+/**
+ * An Aho-Corasick automaton that searches a set of patterns in a single pass.
+ *
+ * The transition table is a dense DFA over byte equivalence classes: bytes that do not appear in any
+ * pattern share a single class, which keeps each state row a few cache lines wide.
+ */
+typedef struct {
+    uint32_t* transitions;
+    size_t* outputs;
+    uint32_t* output_patterns;
+    size_t* lengths;
+    uint16_t classes[256];
+    size_t class_count;
+    size_t state_count;
+    size_t pattern_count;
+} string_view_automaton_t;
 
-#include <ctype.h>
-#include <string.h>
+/**
+ * The state of an automaton scan that spans several chunks of input.
+ */
+typedef struct {
+    uint32_t state;
+    size_t offset;
+} string_view_automaton_stream_t;
 
-inline string_view_t new_string_view(const char* data, size_t size){
-    return (string_view_t) {
-        .data = data,
-        .count = size
-    };
-}
+/**
+ * @brief Builds an Aho-Corasick automaton from an array of patterns.
+ *
+ * This function compiles all the patterns into a deterministic automaton. The patterns are copied
+ * into the automaton tables, so they don't need to outlive it. Empty patterns never match.
+ * The automaton must be released with `string_view_automaton_free`.
+ *
+ * @param automaton A pointer to the automaton to initialize.
+ * @param patterns The array of patterns.
+ * @param count The number of patterns.
+ * @return `true` on success, `false` if the memory allocation failed or the patterns are too large.
+ */
+bool string_view_automaton_init(string_view_automaton_t* automaton, const string_view_t* patterns, size_t count);
 
-inline string_view_t new_string_view_from_cstr(const char* data){
-    return new_string_view(data, strlen(data));
-}
+/**
+ * @brief Releases the memory owned by an automaton.
+ *
+ * @param automaton A pointer to the automaton to release.
+ */
+void string_view_automaton_free(string_view_automaton_t* automaton);
 
-inline char string_view_at(string_view_t sv, size_t index){
-    return index < sv.count
-        ? sv.data[index]
-        : '\0';
-}
+/**
+ * @brief Finds all the occurrences of the automaton patterns in a string view.
+ *
+ * This function scans `haystack` once and stores every (pattern, offset) pair in `matches`, ordered by
+ * the position where the match ends. At most `capacity` matches are stored, but the returned value is
+ * always the total number of matches.
+ *
+ * @param automaton The compiled automaton.
+ * @param haystack The string view to search.
+ * @param matches The output array (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `matches`.
+ * @return The total number of matches.
+ */
+size_t string_view_automaton_find_all(const string_view_automaton_t* automaton, string_view_t haystack,
+                                      string_view_match_t* matches, size_t capacity);
 
-inline char string_view_front(string_view_t sv){    
-    return string_view_at(sv, 0);
-}
+/**
+ * @brief Creates the state for a streaming automaton scan.
+ *
+ * @return A stream positioned at the beginning of the input.
+ */
+string_view_automaton_stream_t new_string_view_automaton_stream(void);
 
-inline char string_view_back(string_view_t sv){
-    return string_view_at(sv, string_view_size(sv) - 1);
-}
+/**
+ * @brief Feeds the next chunk of a stream to the automaton.
+ *
+ * This function continues the scan described by `stream` over `chunk`, so matches that straddle
+ * the boundary between two chunks are found as well. The reported offsets are relative to the
+ * beginning of the whole stream, not to the chunk.
+ *
+ * @param automaton The compiled automaton.
+ * @param stream A pointer to the stream state, updated by the call.
+ * @param chunk The next chunk of input.
+ * @param matches The output array (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `matches`.
+ * @return The total number of matches that end inside `chunk`.
+ */
+size_t string_view_automaton_feed(const string_view_automaton_t* automaton, string_view_automaton_stream_t* stream,
+                                  string_view_t chunk, string_view_match_t* matches, size_t capacity);
 
-inline const char* string_view_data(string_view_t sv){
-    return sv.data;
-}
+/**
+ * A set of byte values compiled for fast membership tests.
+ *
+ * The set is stored both as a 256-bit bitmap and as two 16-entry nibble tables: `low_rows[lo]` has bit
+ * `hi` set when the byte `hi << 4 | lo` is in the set (for `hi < 8`), and `high_rows[lo]` has bit
+ * `hi - 8` set for the other half. Two byte shuffles then classify 16 to 64 bytes at once in constant
+ * time, whatever the size of the set. Sets of 1 to 8 bytes also list them in `chars` (`char_count` is 0
+ * otherwise), so processors without a byte shuffle can compare against each of them instead.
+ */
+typedef struct {
+    uint64_t bits[4];
+    uint8_t low_rows[16];
+    uint8_t high_rows[16];
+    uint8_t chars[8];
+    uint8_t char_count;
+} string_view_charset_t;
 
-inline size_t string_view_size(string_view_t sv){
-    return sv.count;
-}
+/**
+ * @brief Creates a character set from the characters of a string view.
+ *
+ * @param chars The characters of the set.
+ * @return A new character set.
+ */
+string_view_charset_t new_string_view_charset(string_view_t chars);
 
-inline bool string_view_is_empty(string_view_t sv){
-    return sv.count == 0;
-}
+/**
+ * @brief Creates a character set from a predicate evaluated on every byte value.
+ *
+ * The predicate is only called while building the set, so classification functions such as
+ * `isalnum` can be compiled once and then used without touching the locale.
+ *
+ * @param predicate A function returning non-zero for the bytes of the set.
+ * @return A new character set.
+ */
+string_view_charset_t new_string_view_charset_from_predicate(int (*predicate)(int));
 
-void string_view_trim_left(string_view_t *sv) {
-    while(isspace(sv->data[0]) && sv->count > 0){
-        sv->data++;
-        sv->count--;
-    }
-}
+/**
+ * @brief Checks if a character belongs to a character set.
+ *
+ * @param set A pointer to the character set.
+ * @param c The character to check.
+ * @return `true` if the character is in the set, `false` otherwise.
+ */
+bool string_view_charset_contains(const string_view_charset_t* set, char c);
 
-void string_view_trim_right(string_view_t *sv) {
-    while(isspace(string_view_back(*sv)) && sv->count > 0){
-        sv->count--;
-    }
-}
+/**
+ * @brief Finds the first character that belongs to a set.
+ *
+ * @param sv The string view to search.
+ * @param set A pointer to the character set.
+ * @param start The position at which to start the search.
+ * @return The position of the first matching character, or `STRING_VIEW_NPOS` if there is none.
+ */
+size_t string_view_find_first_of(string_view_t sv, const string_view_charset_t* set, size_t start);
 
-inline void string_view_trim(string_view_t *sv){
-    string_view_trim_left(sv);
-    string_view_trim_right(sv);
-}
+/**
+ * @brief Finds the first character that does not belong to a set.
+ *
+ * @param sv The string view to search.
+ * @param set A pointer to the character set.
+ * @param start The position at which to start the search.
+ * @return The position of the first non-matching character, or `STRING_VIEW_NPOS` if there is none.
+ */
+size_t string_view_find_first_not_of(string_view_t sv, const string_view_charset_t* set, size_t start);
 
-void string_view_remove_prefix(string_view_t *sv, size_t n){
-    if(n > sv->count){
-        *sv = STRING_VIEW_EMPTY;
-    }else{
-        sv->data += n;
-        sv->count -= n;
-    }
-}
+/**
+ * @brief Finds the last character that belongs to a set.
+ *
+ * @param sv The string view to search.
+ * @param set A pointer to the character set.
+ * @param start The last position to consider (`STRING_VIEW_NPOS` searches the whole view).
+ * @return The position of the last matching character, or `STRING_VIEW_NPOS` if there is none.
+ */
+size_t string_view_find_last_of(string_view_t sv, const string_view_charset_t* set, size_t start);
 
-inline void string_view_remove_suffix(string_view_t *sv, size_t n){
-    sv->count -= (n > sv->count)
-        ? sv->count
-        : n;
-}
+/**
+ * @brief Finds the last character that does not belong to a set.
+ *
+ * @param sv The string view to search.
+ * @param set A pointer to the character set.
+ * @param start The last position to consider (`STRING_VIEW_NPOS` searches the whole view).
+ * @return The position of the last non-matching character, or `STRING_VIEW_NPOS` if there is none.
+ */
+size_t string_view_find_last_not_of(string_view_t sv, const string_view_charset_t* set, size_t start);
 
-void string_view_swap(string_view_t* sv1, string_view_t* sv2){
-    string_view_t tmp = *sv1;
-    *sv1 = *sv2;
-    *sv2 = tmp;
-}
+/**
+ * @brief Trims the characters of a set from both ends of a string view.
+ *
+ * @param sv A pointer to the string view to be trimmed.
+ * @param set A pointer to the character set to remove.
+ */
+void string_view_trim_chars(string_view_t* sv, const string_view_charset_t* set);
 
-void string_view_copy(string_view_t sv, char *dest, size_t count, size_t start){
+/**
+ * Kinds of delimiter supported by the split iterator.
+ */
+typedef enum {
+    STRING_VIEW_SPLIT_CHAR = 0,   /**< A single delimiter character. */
+    STRING_VIEW_SPLIT_ANY,        /**< Any character of a delimiter set. */
+    STRING_VIEW_SPLIT_SUBSTRING   /**< A delimiter substring. */
+} string_view_split_mode_t;
 
-    if(dest == NULL || start >= sv.count) return;
-    if(sv.count - start < count) {
-        count = sv.count - start;
-    }
+/**
+ * A zero-copy iterator over the tokens of a string view.
+ *
+ * Tokens are views into the original data. Consecutive delimiters produce empty tokens, and a view
+ * with `n` delimiters always produces `n + 1` tokens.
+ */
+typedef struct {
+    string_view_t rest;
+    string_view_t delimiter;
+    char character;
+    string_view_split_mode_t mode;
+    bool done;
+    string_view_charset_t set;
+} string_view_split_iter_t;
 
-    memcpy(dest, &sv.data[start], count);
-}
+/**
+ * @brief Creates a split iterator that separates tokens on a single character.
+ *
+ * @param sv The string view to split.
+ * @param delimiter The delimiter character.
+ * @return A new split iterator.
+ */
+string_view_split_iter_t new_string_view_split_iter_char(string_view_t sv, char delimiter);
 
-string_view_t string_view_substr(string_view_t sv, size_t start, size_t count){  
-    if(count > (sv.count - start)) {
-        count = sv.count - start;
-    }
+/**
+ * @brief Creates a split iterator that separates tokens on any character of a set.
+ *
+ * @param sv The string view to split.
+ * @param delimiters The delimiter characters.
+ * @return A new split iterator.
+ */
+string_view_split_iter_t new_string_view_split_iter_any(string_view_t sv, string_view_t delimiters);
 
-    return (start < sv.count) 
-        ? new_string_view(&sv.data[start], count)
-        : STRING_VIEW_EMPTY;
-}
+/**
+ * @brief Creates a split iterator that separates tokens on a delimiter substring.
+ *
+ * An empty delimiter never matches, so the whole view is returned as a single token.
+ *
+ * @param sv The string view to split.
+ * @param delimiter The delimiter substring. It must outlive the iterator.
+ * @return A new split iterator.
+ */
+string_view_split_iter_t new_string_view_split_iter_substring(string_view_t sv, string_view_t delimiter);
 
-int string_view_compare(const string_view_t sv1, const string_view_t sv2){
-    
-    if(sv1.count > sv2.count) return 1;
-    if(sv1.count < sv2.count) return -1;
-    
-    return strncmp(sv1.data, sv2.data, sv1.count);
-}
+/**
+ * @brief Advances a split iterator to the next token.
+ *
+ * @param iter A pointer to the split iterator.
+ * @param token A pointer where the next token is stored.
+ * @return `true` if a token was produced, `false` when the iterator is exhausted.
+ */
+bool string_view_split_next(string_view_split_iter_t* iter, string_view_t* token);
 
-inline bool string_view_equal(string_view_t sv1, string_view_t sv2){
-    return string_view_compare(sv1, sv2) == 0;
-}
+/**
+ * @brief Splits a string view on a set of delimiter characters in a single pass.
+ *
+ * This function locates the delimiters 64 bytes at a time as SIMD bitmasks and stores the tokens
+ * in `tokens` without calling any function per token. At most `capacity` tokens are stored, but the
+ * returned value is always the total number of tokens, so the function can also size the output array.
+ *
+ * @param sv The string view to split.
+ * @param delimiters The delimiter characters.
+ * @param tokens The output array (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `tokens`.
+ * @return The total number of tokens.
+ */
+size_t string_view_split_into(string_view_t sv, string_view_t delimiters, string_view_t* tokens, size_t capacity);
 
-inline bool string_view_starts_with(string_view_t sv, string_view_t prefix){
-    if(prefix.count > sv.count) return false;
-    return strncmp(sv.data, prefix.data, prefix.count) == 0;
-}
+/**
+ * A zero-copy iterator over the lines of a string view.
+ *
+ * Lines are terminated by `\n` or `\r\n`; the terminator is not part of the line. A final line
+ * without terminator is returned too, but a trailing terminator does not produce an extra empty line.
+ */
+typedef struct {
+    string_view_t rest;
+} string_view_line_iter_t;
 
+/**
+ * @brief Creates an iterator over the lines of a string view.
+ *
+ * @param sv The string view to iterate.
+ * @return A new line iterator.
+ */
+string_view_line_iter_t new_string_view_line_iter(string_view_t sv);
 
-bool string_view_ends_with(string_view_t sv, string_view_t suffix){
-    
-    if(suffix.count > sv.count) return false;
+/**
+ * @brief Advances a line iterator to the next line.
+ *
+ * This function uses the vectorized character search to locate the next newline, so scanning
+ * a large buffer costs a single pass and no copies.
+ *
+ * @param iter A pointer to the line iterator.
+ * @param line A pointer where the next line is stored.
+ * @return `true` if a line was produced, `false` when the iterator is exhausted.
+ */
+bool string_view_line_next(string_view_line_iter_t* iter, string_view_t* line);
 
-    const size_t pos = sv.count - suffix.count;
-    return strncmp(&sv.data[pos], suffix.data, suffix.count) == 0;
-}
+/**
+ * The callback used by a streaming reader to refill its buffer.
+ *
+ * It must store at most `capacity` bytes in `buffer` and return the number of bytes stored,
+ * 0 at the end of the input or a negative value on error.
+ */
+typedef ptrdiff_t (*string_view_read_fn)(void* context, char* buffer, size_t capacity);
 
-size_t string_view_find_char(string_view_t sv, char c, size_t start){
+/**
+ * A streaming reader that yields delimited records as views into its own buffer.
+ *
+ * Records are handed out without copies; only the incomplete record left at the end of the
+ * buffer is moved to the front before a refill. The statistics report how many bytes were copied
+ * that way and how many were yielded zero-copy.
+ */
+typedef struct {
+    char* buffer;
+    size_t capacity;
+    size_t begin;
+    size_t end;
+    size_t scanned;
+    char delimiter;
+    bool eof;
+    bool error;
+    string_view_read_fn read;
+    void* context;
+    size_t bytes_copied;
+    size_t bytes_yielded;
+    size_t records;
+} string_view_reader_t;
 
-    for(size_t i = start; i < sv.count; i++){
-        if(sv.data[i] == c) return i;
+/**
+ * @brief Initializes a streaming reader.
+ *
+ * The buffer starts with `capacity` bytes and doubles whenever a single record does not fit in it.
+ * The reader must be released with `string_view_reader_free`.
+ *
+ * @param reader A pointer to the reader to initialize.
+ * @param capacity The initial size of the buffer.
+ * @param delimiter The character that terminates each record.
+ * @param read The callback that refills the buffer.
+ * @param context The opaque pointer passed to `read`.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_reader_init(string_view_reader_t* reader, size_t capacity, char delimiter,
+                             string_view_read_fn read, void* context);
+
+/**
+ * @brief Releases the buffer owned by a streaming reader.
+ *
+ * @param reader A pointer to the reader to release.
+ */
+void string_view_reader_free(string_view_reader_t* reader);
+
+/**
+ * @brief Reads the next record from a streaming reader.
+ *
+ * The record does not include its delimiter. The final record of the input is returned even if it
+ * is not terminated, but a trailing delimiter does not produce an extra empty record.
+ * The returned view stays valid until the next call on the same reader.
+ *
+ * @param reader A pointer to the reader.
+ * @param record A pointer where the next record is stored.
+ * @return `true` if a record was produced, `false` at the end of the input or on a read error
+ *         (in which case `reader->error` is set).
+ */
+bool string_view_reader_next(string_view_reader_t* reader, string_view_t* record);
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STRING_VIEW_HAS_MMAP 1
+#define STRING_VIEW_HAS_THREADS 1
+
+/**
+ * Access pattern hints for memory-mapped files.
+ */
+typedef enum {
+    STRING_VIEW_ADVICE_NORMAL = 0,
+    STRING_VIEW_ADVICE_SEQUENTIAL,
+    STRING_VIEW_ADVICE_RANDOM,
+    STRING_VIEW_ADVICE_WILLNEED
+} string_view_advice_t;
+
+/**
+ * A read-only memory-mapped file exposed as a string view.
+ */
+typedef struct {
+    string_view_t view;
+    void* address;
+    size_t size;
+} string_view_mmap_t;
+
+/**
+ * @brief Maps a file in memory and exposes its content as a string view.
+ *
+ * This function maps the whole file read-only, so the content is paged in lazily by the
+ * operating system instead of being copied into a heap buffer. An empty file produces an empty view.
+ * The mapping must be released with `string_view_mmap_close`.
+ *
+ * @param map A pointer to the mapping to initialize.
+ * @param path The path of the file.
+ * @param advice The expected access pattern.
+ * @return `true` on success, `false` if the file could not be opened or mapped.
+ */
+bool string_view_mmap_open(string_view_mmap_t* map, const char* path, string_view_advice_t advice);
+
+/**
+ * @brief Changes the access pattern hint of a memory-mapped file.
+ *
+ * @param map A pointer to the mapping.
+ * @param advice The expected access pattern.
+ * @return `true` on success, `false` otherwise.
+ */
+bool string_view_mmap_advise(string_view_mmap_t* map, string_view_advice_t advice);
+
+/**
+ * @brief Unmaps a memory-mapped file.
+ *
+ * All the string views that point into the mapping become invalid.
+ *
+ * @param map A pointer to the mapping to release.
+ */
+void string_view_mmap_close(string_view_mmap_t* map);
+
+/**
+ * @brief A `string_view_read_fn` that reads from a file descriptor.
+ *
+ * The context must point to an `int` holding the file descriptor, which makes it
+ * straightforward to stream records from pipes and sockets.
+ *
+ * @param context A pointer to the file descriptor.
+ * @param buffer The buffer to fill.
+ * @param capacity The size of the buffer.
+ * @return The number of bytes read, 0 at the end of the input or a negative value on error.
+ */
+ptrdiff_t string_view_read_fd(void* context, char* buffer, size_t capacity);
+
+#endif
+
+/**
+ * @brief Computes a seeded 64-bit hash of a string view.
+ *
+ * This function implements a fast non-cryptographic hash of the wyhash family: views up to 16 bytes
+ * take a short branch-light path, longer views are consumed 48 bytes at a time with three independent
+ * 64-bit multiply lanes. Equal views always produce equal hashes for the same seed.
+ * The hash is not suitable for cryptographic use and its values may differ between CPU endiannesses.
+ *
+ * @param sv The string view to hash.
+ * @param seed The seed of the hash function.
+ * @return The 64-bit hash value.
+ */
+uint64_t string_view_hash(string_view_t sv, uint64_t seed);
+
+/**
+ * @brief Hashes an array of string views.
+ *
+ * This function produces the same values as `string_view_hash`, but processes the views in groups
+ * of four with interleaved loads and prefetches the data of the following views, so the memory
+ * latency of one key is hidden behind the work on the others.
+ *
+ * @param views The array of string views to hash.
+ * @param count The number of views.
+ * @param seed The seed of the hash function.
+ * @param hashes The output array, with room for `count` hash values.
+ */
+void string_view_hash_many(const string_view_t* views, size_t count, uint64_t seed, uint64_t* hashes);
+
+/**
+ * A 16-byte string view that keeps the beginning of the string inline.
+ *
+ * The first 8 bytes hold the length and the first 4 characters. Strings of up to 12 characters are
+ * stored entirely inline (zero-padded), longer strings keep a pointer to their data in the last
+ * 8 bytes. Most comparisons are therefore settled by the inline bytes alone, without dereferencing
+ * the string data. An inline string lives inside the struct, so views obtained from it are only valid
+ * as long as the struct itself.
+ */
+typedef struct {
+    uint32_t count;
+    char prefix[4];
+    union {
+        char inline_data[8];
+        const char* data;
+    } payload;
+} string_view_prefixed_t;
+
+/**
+ * @brief Creates a prefixed string view from a string view.
+ *
+ * Strings longer than 12 characters are not copied and must outlive the prefixed view.
+ *
+ * @param sv The string view. Its length must fit in 32 bits.
+ * @return A new prefixed string view.
+ */
+string_view_prefixed_t new_string_view_prefixed(string_view_t sv);
+
+/**
+ * @brief Returns a regular string view of a prefixed string view.
+ *
+ * @param sv A pointer to the prefixed string view.
+ * @return A string view of the same characters.
+ */
+string_view_t string_view_prefixed_to_view(const string_view_prefixed_t* sv);
+
+/**
+ * @brief Checks if two prefixed string views are equal.
+ *
+ * The length and the first 4 characters are compared at once, and the string data is only read when
+ * both views are longer than 12 characters and share their prefix.
+ *
+ * @param sv1 A pointer to the first prefixed string view.
+ * @param sv2 A pointer to the second prefixed string view.
+ * @return `true` if the views contain the same characters, `false` otherwise.
+ */
+bool string_view_prefixed_equal(const string_view_prefixed_t* sv1, const string_view_prefixed_t* sv2);
+
+/**
+ * @brief Compares two prefixed string views lexicographically.
+ *
+ * The order is the same as `string_view_compare`. The string data is only read when the first
+ * 4 characters are equal and one of the views is longer than 12 characters.
+ *
+ * @param sv1 A pointer to the first prefixed string view.
+ * @param sv2 A pointer to the second prefixed string view.
+ * @return A negative value, zero or a positive value if `sv1` is less than, equal to or greater than `sv2`.
+ */
+int string_view_prefixed_compare(const string_view_prefixed_t* sv1, const string_view_prefixed_t* sv2);
+
+/**
+ * @brief Computes the hash of a prefixed string view.
+ *
+ * The result is the same as `string_view_hash` on the equivalent string view.
+ *
+ * @param sv A pointer to the prefixed string view.
+ * @param seed The seed of the hash.
+ * @return The 64-bit hash.
+ */
+uint64_t string_view_prefixed_hash(const string_view_prefixed_t* sv, uint64_t seed);
+
+/**
+ * A slot of a string view map: the key, its first bytes inline and the associated value.
+ */
+typedef struct {
+    const char* data;
+    size_t count;
+    uint64_t prefix;
+    uint64_t value;
+} string_view_map_slot_t;
+
+/**
+ * An open-addressing hash map from string views to 64-bit values.
+ *
+ * The map follows the Swiss table design: every slot has a control byte holding 7 bits of the key
+ * hash, and groups of 16 control bytes are probed at once with SIMD compares. Each slot keeps the key
+ * length and its first 8 bytes inline, so most mismatches (and every key up to 8 bytes) are resolved
+ * without dereferencing the key data. Keys are not copied and must outlive the map.
+ */
+typedef struct {
+    uint8_t* control;
+    string_view_map_slot_t* slots;
+    size_t capacity;
+    size_t size;
+    size_t tombstones;
+    uint64_t seed;
+} string_view_map_t;
+
+/**
+ * @brief Initializes an empty string view map.
+ *
+ * The map must be released with `string_view_map_free`.
+ *
+ * @param map A pointer to the map to initialize.
+ * @param capacity The number of keys the map can hold before growing.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_map_init(string_view_map_t* map, size_t capacity);
+
+/**
+ * @brief Releases the memory owned by a string view map.
+ *
+ * @param map A pointer to the map to release.
+ */
+void string_view_map_free(string_view_map_t* map);
+
+/**
+ * @brief Makes room for at least `count` keys without further rehashing.
+ *
+ * @param map A pointer to the map.
+ * @param count The number of keys the map must be able to hold.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_map_reserve(string_view_map_t* map, size_t count);
+
+/**
+ * @brief Inserts a key in the map or updates the value of an existing key.
+ *
+ * @param map A pointer to the map.
+ * @param key The key. It is not copied and must outlive the map.
+ * @param value The value associated with the key.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_map_insert(string_view_map_t* map, string_view_t key, uint64_t value);
+
+/**
+ * @brief Looks up the value associated with a key.
+ *
+ * @param map A pointer to the map.
+ * @param key The key to look up.
+ * @param value A pointer where the value is stored when the key is found (can be `NULL`).
+ * @return `true` if the key is in the map, `false` otherwise.
+ */
+bool string_view_map_lookup(const string_view_map_t* map, string_view_t key, uint64_t* value);
+
+/**
+ * @brief Removes a key from the map.
+ *
+ * @param map A pointer to the map.
+ * @param key The key to remove.
+ * @return `true` if the key was removed, `false` if it was not in the map.
+ */
+bool string_view_map_remove(string_view_map_t* map, string_view_t key);
+
+/**
+ * @brief Looks up an array of keys.
+ *
+ * This function hashes the keys in batches and prefetches all the control groups and slots of a batch
+ * before probing them, so the cache misses of different keys overlap instead of being paid one by one.
+ *
+ * @param map A pointer to the map.
+ * @param keys The keys to look up.
+ * @param count The number of keys.
+ * @param values The output array for the values (the entries of missing keys are left untouched).
+ * @param found The output array telling whether each key was found (can be `NULL`).
+ * @return The number of keys found.
+ */
+size_t string_view_map_lookup_batch(const string_view_map_t* map, const string_view_t* keys, size_t count,
+                                    uint64_t* values, bool* found);
+
+/**
+ * @brief Inserts an array of keys in the map.
+ *
+ * This function reserves room for all the keys up front, then inserts them with the same batched
+ * hashing and prefetching as `string_view_map_lookup_batch`. Existing keys get their value updated.
+ *
+ * @param map A pointer to the map.
+ * @param keys The keys to insert. They are not copied and must outlive the map.
+ * @param values The values associated with the keys.
+ * @param count The number of keys.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_map_insert_batch(string_view_map_t* map, const string_view_t* keys, const uint64_t* values, size_t count);
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STRING_VIEW_HAS_ATOMICS 1
+
+/**
+ * A concurrent string interning pool.
+ *
+ * Every distinct string is copied once into an arena owned by the pool and gets a stable id, so
+ * interned strings can be compared by id or by data pointer. The slot table never moves and has at
+ * least twice as many slots as the pool can hold strings: lookups are wait-free loads, insertions
+ * claim an empty slot with a single compare-and-swap, and the arena hands out memory with an atomic
+ * bump pointer. Any number of threads can intern and look up strings at the same time; only
+ * initialization and release must be exclusive.
+ */
+typedef struct {
+    struct string_view__intern_record** slots;
+    struct string_view__intern_block* blocks;
+    size_t slot_count;
+    size_t capacity;
+    size_t size;
+    size_t reserved;
+    uint64_t seed;
+} string_view_intern_pool_t;
+
+/**
+ * @brief Initializes an empty intern pool.
+ *
+ * The pool must be released with `string_view_intern_pool_free`.
+ *
+ * @param pool A pointer to the pool to initialize.
+ * @param capacity The maximum number of distinct strings the pool can hold.
+ * @return `true` on success, `false` if the memory allocation failed.
+ */
+bool string_view_intern_pool_init(string_view_intern_pool_t* pool, size_t capacity);
+
+/**
+ * @brief Releases the pool and all the strings interned in it.
+ *
+ * This function must not run concurrently with any other use of the pool.
+ *
+ * @param pool A pointer to the pool to release.
+ */
+void string_view_intern_pool_free(string_view_intern_pool_t* pool);
+
+/**
+ * @brief Interns a string.
+ *
+ * This function returns the id of the string, copying it into the pool if it was not interned yet.
+ * The canonical view is NUL-terminated and stays valid until the pool is released, and two calls
+ * with equal strings always return the same id and the same canonical data pointer. When two threads
+ * race to intern the same new string, the loser's copy is handed back to the arena unless another
+ * allocation already followed it, in which case it stays unused until the pool is released.
+ *
+ * @param pool A pointer to the pool.
+ * @param sv The string to intern.
+ * @param canonical A pointer where the canonical view is stored (can be `NULL`).
+ * @return The id of the string (smaller than `pool->slot_count`), or `STRING_VIEW_NPOS` if the pool
+ *         already holds `pool->capacity` strings or the memory allocation failed.
+ */
+size_t string_view_intern(string_view_intern_pool_t* pool, string_view_t sv, string_view_t* canonical);
+
+/**
+ * @brief Looks up a string without interning it.
+ *
+ * @param pool A pointer to the pool.
+ * @param sv The string to look up.
+ * @param canonical A pointer where the canonical view is stored when the string is found (can be `NULL`).
+ * @return The id of the string, or `STRING_VIEW_NPOS` if it is not interned.
+ */
+size_t string_view_intern_find(const string_view_intern_pool_t* pool, string_view_t sv, string_view_t* canonical);
+
+/**
+ * @brief Returns the canonical view of an interned string from its id.
+ *
+ * @param pool A pointer to the pool.
+ * @param id The id returned by `string_view_intern`.
+ * @return The canonical view, or an empty view if no string has this id.
+ */
+string_view_t string_view_intern_get(const string_view_intern_pool_t* pool, size_t id);
+
+/**
+ * @brief Returns the number of distinct strings interned in the pool.
+ *
+ * @param pool A pointer to the pool.
+ * @return The number of interned strings.
+ */
+size_t string_view_intern_count(const string_view_intern_pool_t* pool);
+#endif
+
+/**
+ * A bump allocator that owns copies of string views.
+ *
+ * Memory is carved out of large blocks and released all at once, either by rewinding to a mark, by
+ * resetting the arena or by freeing it. Rewinding and resetting keep the blocks around so the next
+ * allocations reuse them. `bytes_used` counts the bytes handed out (including alignment padding) and
+ * `blocks_allocated` the blocks obtained from `STRING_VIEW_MALLOC`.
+ */
+typedef struct {
+    struct string_view__arena_block* first;
+    struct string_view__arena_block* current;
+    char* cursor;
+    char* end;
+    size_t block_size;
+    size_t bytes_used;
+    size_t blocks_allocated;
+} string_view_arena_t;
+
+/**
+ * A position in an arena, used to release everything allocated after it.
+ */
+typedef struct {
+    struct string_view__arena_block* block;
+    char* cursor;
+    size_t bytes_used;
+} string_view_arena_mark_t;
+
+/**
+ * @brief Initializes an empty arena.
+ *
+ * No memory is allocated until the first allocation. The arena must be released with
+ * `string_view_arena_free`.
+ *
+ * @param arena A pointer to the arena to initialize.
+ * @param block_size The size of the blocks requested from the allocator (0 selects a default size).
+ */
+void string_view_arena_init(string_view_arena_t* arena, size_t block_size);
+
+/**
+ * @brief Releases all the blocks of an arena.
+ *
+ * Every view allocated from the arena becomes invalid.
+ *
+ * @param arena A pointer to the arena to release.
+ */
+void string_view_arena_free(string_view_arena_t* arena);
+
+/**
+ * @brief Allocates uninitialized memory from an arena.
+ *
+ * The returned memory is aligned for any fundamental type.
+ *
+ * @param arena A pointer to the arena.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the memory, or `NULL` if the memory allocation failed.
+ */
+void* string_view_arena_alloc(string_view_arena_t* arena, size_t size);
+
+/**
+ * @brief Copies a string view into an arena.
+ *
+ * @param arena A pointer to the arena.
+ * @param sv The string view to copy.
+ * @return A view of the copy, or a view with `NULL` data if the memory allocation failed.
+ */
+string_view_t string_view_arena_dup(string_view_arena_t* arena, string_view_t sv);
+
+/**
+ * @brief Copies a string view into an arena as a null-terminated string.
+ *
+ * @param arena A pointer to the arena.
+ * @param sv The string view to copy.
+ * @return The null-terminated copy, or `NULL` if the memory allocation failed.
+ */
+char* string_view_arena_dup_cstr(string_view_arena_t* arena, string_view_t sv);
+
+/**
+ * @brief Concatenates string views into an arena.
+ *
+ * The result is followed by a null terminator that is not part of the view.
+ *
+ * @param arena A pointer to the arena.
+ * @param views The string views to concatenate.
+ * @param count The number of string views.
+ * @return A view of the concatenation, or a view with `NULL` data if the memory allocation failed.
+ */
+string_view_t string_view_arena_concat(string_view_arena_t* arena, const string_view_t* views, size_t count);
+
+/**
+ * @brief Returns the current position of an arena.
+ *
+ * @param arena A pointer to the arena.
+ * @return A mark that can be passed to `string_view_arena_rewind`.
+ */
+string_view_arena_mark_t string_view_arena_mark(const string_view_arena_t* arena);
+
+/**
+ * @brief Releases everything allocated after a mark.
+ *
+ * The blocks are kept and reused by the following allocations.
+ *
+ * @param arena A pointer to the arena.
+ * @param mark A mark previously returned by `string_view_arena_mark` on the same arena.
+ */
+void string_view_arena_rewind(string_view_arena_t* arena, string_view_arena_mark_t mark);
+
+/**
+ * @brief Releases everything allocated from an arena, keeping its blocks for reuse.
+ *
+ * @param arena A pointer to the arena.
+ */
+void string_view_arena_reset(string_view_arena_t* arena);
+
+/**
+ * A growable string assembled from views, characters and integers.
+ *
+ * A builder either owns a heap buffer that grows geometrically, or writes into a fixed buffer
+ * provided by the caller and never allocates. When an append does not fit in a fixed buffer the
+ * builder is left unchanged, the append returns `false` and `overflow` is set. The content is always
+ * null-terminated.
+ */
+typedef struct {
+    char* data;
+    size_t count;
+    size_t capacity;
+    bool owned;
+    bool overflow;
+} string_builder_t;
+
+/**
+ * @brief Creates an empty builder backed by the heap.
+ *
+ * No memory is allocated until the first append. The builder must be released with
+ * `string_builder_free`.
+ *
+ * @return A new string builder.
+ */
+string_builder_t new_string_builder(void);
+
+/**
+ * @brief Creates an empty builder that writes into a caller-provided buffer.
+ *
+ * @param buffer The buffer to write into.
+ * @param capacity The size of the buffer in bytes, including the null terminator.
+ * @return A new string builder.
+ */
+string_builder_t new_string_builder_fixed(char* buffer, size_t capacity);
+
+/**
+ * @brief Releases the heap buffer of a builder.
+ *
+ * @param builder A pointer to the builder.
+ */
+void string_builder_free(string_builder_t* builder);
+
+/**
+ * @brief Makes room for `count` more bytes, so the following appends do not reallocate.
+ *
+ * @param builder A pointer to the builder.
+ * @param count The number of bytes to reserve.
+ * @return `true` on success, `false` if the memory allocation failed or the fixed buffer is too small.
+ */
+bool string_builder_reserve(string_builder_t* builder, size_t count);
+
+/**
+ * @brief Empties a builder, keeping its buffer.
+ *
+ * @param builder A pointer to the builder.
+ */
+void string_builder_clear(string_builder_t* builder);
+
+/**
+ * @brief Returns a view of the content of a builder.
+ *
+ * The view is invalidated by the next append on a heap builder.
+ *
+ * @param builder A pointer to the builder.
+ * @return A view of the content.
+ */
+string_view_t string_builder_view(const string_builder_t* builder);
+
+/**
+ * @brief Appends a string view.
+ *
+ * @param builder A pointer to the builder.
+ * @param sv The string view to append.
+ * @return `true` on success, `false` if the content did not fit.
+ */
+bool string_builder_append(string_builder_t* builder, string_view_t sv);
+
+/**
+ * @brief Appends a character.
+ *
+ * @param builder A pointer to the builder.
+ * @param c The character to append.
+ * @return `true` on success, `false` if the content did not fit.
+ */
+bool string_builder_append_char(string_builder_t* builder, char c);
+
+/**
+ * @brief Appends the decimal representation of a signed integer.
+ *
+ * @param builder A pointer to the builder.
+ * @param value The integer to append.
+ * @return `true` on success, `false` if the content did not fit.
+ */
+bool string_builder_append_int(string_builder_t* builder, int64_t value);
+
+/**
+ * @brief Appends the decimal representation of an unsigned integer.
+ *
+ * @param builder A pointer to the builder.
+ * @param value The integer to append.
+ * @return `true` on success, `false` if the content did not fit.
+ */
+bool string_builder_append_uint(string_builder_t* builder, uint64_t value);
+
+/**
+ * @brief Appends string views separated by a separator.
+ *
+ * This function computes the total size first, so the builder grows at most once.
+ *
+ * @param builder A pointer to the builder.
+ * @param views The string views to append.
+ * @param count The number of string views.
+ * @param separator The separator inserted between consecutive views.
+ * @return `true` on success, `false` if the content did not fit.
+ */
+bool string_builder_append_join(string_builder_t* builder, const string_view_t* views, size_t count,
+                                string_view_t separator);
+
+/**
+ * @brief Joins string views with a separator into a new null-terminated string.
+ *
+ * This function computes the total size first and performs a single allocation. The result must be
+ * released by passing its data to `STRING_VIEW_FREE`.
+ *
+ * @param views The string views to join.
+ * @param count The number of string views.
+ * @param separator The separator inserted between consecutive views.
+ * @return A view of the joined string, or a view with `NULL` data if the memory allocation failed.
+ */
+string_view_t string_view_join(const string_view_t* views, size_t count, string_view_t separator);
+
+/**
+ * The outcome of a numeric parse.
+ */
+typedef enum {
+    STRING_VIEW_PARSE_OK,
+    STRING_VIEW_PARSE_INVALID,
+    STRING_VIEW_PARSE_OUT_OF_RANGE
+} string_view_parse_status_t;
+
+/**
+ * The result of a numeric parse: the number of bytes consumed from the start of the view and the status.
+ *
+ * Parsing stops at the first byte that cannot continue the number, like `std::from_chars`. When the
+ * status is `STRING_VIEW_PARSE_INVALID`, nothing was consumed and the value is left untouched.
+ */
+typedef struct {
+    size_t consumed;
+    string_view_parse_status_t status;
+} string_view_parse_result_t;
+
+/**
+ * @brief Parses a signed decimal integer from the start of a string view.
+ *
+ * This function accepts an optional `+` or `-` sign followed by decimal digits, without leading
+ * whitespace and independently of the locale. Eight digits are converted per step when available.
+ * Out of range values are clamped to `INT64_MIN` or `INT64_MAX`.
+ *
+ * @param sv The string view to parse.
+ * @param value A pointer where the parsed value is stored.
+ * @return The number of bytes consumed and the status of the parse.
+ */
+string_view_parse_result_t string_view_parse_i64(string_view_t sv, int64_t* value);
+
+/**
+ * @brief Parses an unsigned decimal integer from the start of a string view.
+ *
+ * This function accepts an optional `+` sign followed by decimal digits. Out of range values are
+ * clamped to `UINT64_MAX`.
+ *
+ * @param sv The string view to parse.
+ * @param value A pointer where the parsed value is stored.
+ * @return The number of bytes consumed and the status of the parse.
+ */
+string_view_parse_result_t string_view_parse_u64(string_view_t sv, uint64_t* value);
+
+/**
+ * @brief Parses a decimal floating-point number from the start of a string view.
+ *
+ * This function accepts an optional sign, digits with an optional decimal point, an optional
+ * exponent (`e` or `E`), as well as `inf`, `infinity` and `nan` in any case. The result is correctly
+ * rounded to nearest, ties to even. Values too large for a double give an infinity and non-zero
+ * values too small give zero, both with the `STRING_VIEW_PARSE_OUT_OF_RANGE` status.
+ *
+ * @param sv The string view to parse.
+ * @param value A pointer where the parsed value is stored.
+ * @return The number of bytes consumed and the status of the parse.
+ */
+string_view_parse_result_t string_view_parse_f64(string_view_t sv, double* value);
+
+/**
+ * @brief Parses an array of string views as signed integers.
+ *
+ * Each view must contain exactly one number, with nothing before or after it.
+ *
+ * @param views The string views to parse.
+ * @param count The number of string views.
+ * @param values The output array for the parsed values.
+ * @return The index of the first view that could not be parsed, or `count` if all of them were.
+ */
+size_t string_view_parse_i64_batch(const string_view_t* views, size_t count, int64_t* values);
+
+/**
+ * @brief Parses an array of string views as unsigned integers.
+ *
+ * Each view must contain exactly one number, with nothing before or after it.
+ *
+ * @param views The string views to parse.
+ * @param count The number of string views.
+ * @param values The output array for the parsed values.
+ * @return The index of the first view that could not be parsed, or `count` if all of them were.
+ */
+size_t string_view_parse_u64_batch(const string_view_t* views, size_t count, uint64_t* values);
+
+/**
+ * @brief Parses an array of string views as floating-point numbers.
+ *
+ * Each view must contain exactly one number, with nothing before or after it.
+ *
+ * @param views The string views to parse.
+ * @param count The number of string views.
+ * @param values The output array for the parsed values.
+ * @return The index of the first view that could not be parsed, or `count` if all of them were.
+ */
+size_t string_view_parse_f64_batch(const string_view_t* views, size_t count, double* values);
+
+#ifdef STRING_VIEW_HAS_THREADS
+
+/**
+ * A pool of worker threads used by the parallel scanning functions.
+ *
+ * The calling thread takes part in every parallel call, so a pool of `n` threads starts `n - 1`
+ * workers. Parallel calls on the same pool from different threads are serialized.
+ */
+typedef struct {
+    struct string_view__thread_pool_state* state;
+    size_t thread_count;
+} string_view_thread_pool_t;
+
+/**
+ * @brief Starts a pool of worker threads.
+ *
+ * The pool must be released with `string_view_thread_pool_free`.
+ *
+ * @param pool A pointer to the pool to initialize.
+ * @param thread_count The number of threads taking part in each call, the caller included
+ *                     (0 selects the number of online processors).
+ * @return `true` on success, `false` if the memory allocation or a thread creation failed.
+ */
+bool string_view_thread_pool_init(string_view_thread_pool_t* pool, size_t thread_count);
+
+/**
+ * @brief Stops the worker threads of a pool and releases it.
+ *
+ * @param pool A pointer to the pool to release.
+ */
+void string_view_thread_pool_free(string_view_thread_pool_t* pool);
+
+/**
+ * @brief Finds the first occurrence of a substring using a pool of threads.
+ *
+ * The haystack is split into chunks that overlap by `needle.count - 1` bytes, so occurrences across
+ * chunk boundaries are found, and the chunks are scanned in parallel. Chunks that start after an
+ * occurrence already found are skipped.
+ *
+ * @param pool A pointer to the thread pool.
+ * @param haystack The string view to search.
+ * @param needle The substring to find.
+ * @return The index of the first occurrence, or `STRING_VIEW_NPOS` if not found.
+ */
+size_t string_view_parallel_find_first(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle);
+
+/**
+ * @brief Finds all the occurrences of a substring using a pool of threads.
+ *
+ * The results are the same as `string_view_searcher_find_all`: the indices of all the (possibly
+ * overlapping) occurrences in increasing order, at most `capacity` of them stored.
+ *
+ * @param pool A pointer to the thread pool.
+ * @param haystack The string view to search.
+ * @param needle The substring to find.
+ * @param positions The output array for the match indices (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `positions`.
+ * @return The total number of occurrences.
+ */
+size_t string_view_parallel_find_all(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle,
+                                     size_t* positions, size_t capacity);
+
+/**
+ * @brief Counts the (possibly overlapping) occurrences of a substring using a pool of threads.
+ *
+ * Single-character needles are counted with `string_view_count_char`.
+ *
+ * @param pool A pointer to the thread pool.
+ * @param haystack The string view to scan.
+ * @param needle The substring to count.
+ * @return The number of occurrences.
+ */
+size_t string_view_parallel_count(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle);
+#endif
+
+/**
+ * @brief Validates the UTF-8 encoding of a string view.
+ *
+ * This function checks that the string view is well-formed UTF-8 as defined by the Unicode standard:
+ * no overlong encodings, no surrogates, no code point above U+10FFFF and no truncated sequence.
+ * Blocks of ASCII bytes are skipped at full vector width and the other blocks are classified with
+ * nibble lookup tables, so no byte is decoded unless an error has to be located.
+ *
+ * @param sv The string view to validate.
+ * @return `STRING_VIEW_NPOS` if the string view is valid, otherwise the offset of the first ill-formed sequence.
+ */
+size_t string_view_utf8_validate(string_view_t sv);
+
+/**
+ * @brief Counts the code points of a UTF-8 string view.
+ *
+ * This function counts the bytes that are not continuation bytes, which is the number of code points
+ * of a valid string view. It does not decode anything and runs at the speed of `string_view_count_char`.
+ *
+ * @param sv The string view to scan.
+ * @return The number of code points.
+ */
+size_t string_view_utf8_length(string_view_t sv);
+
+/**
+ * @brief Returns a substring of a UTF-8 string view delimited in code points.
+ *
+ * This function behaves like `string_view_substr`, but `start` and `count` are measured in code
+ * points, so the returned view never begins or ends inside a multi-byte sequence.
+ *
+ * @param sv The string view to slice.
+ * @param start The index of the first code point.
+ * @param count The maximum number of code points.
+ * @return The substring, or an empty string view if `start` is past the last code point.
+ */
+string_view_t string_view_utf8_substr(string_view_t sv, size_t start, size_t count);
+
+/**
+ * A zero-copy iterator over the code points of a UTF-8 string view.
+ *
+ * Each ill-formed sequence, taken as its longest valid prefix or a single byte, produces one U+FFFD
+ * replacement character, following the Unicode recommendation for decoders.
+ */
+typedef struct {
+    string_view_t rest;
+} string_view_utf8_iter_t;
+
+/**
+ * @brief Creates an iterator over the code points of a UTF-8 string view.
+ *
+ * @param sv The string view to iterate.
+ * @return A new code point iterator.
+ */
+string_view_utf8_iter_t new_string_view_utf8_iter(string_view_t sv);
+
+/**
+ * @brief Advances a code point iterator to the next code point.
+ *
+ * @param iter A pointer to the code point iterator.
+ * @param code_point A pointer where the decoded code point is stored.
+ * @return `true` if a code point was produced, `false` when the iterator is exhausted.
+ */
+bool string_view_utf8_next(string_view_utf8_iter_t* iter, uint32_t* code_point);
+
+/**
+ * A zero-copy reader of CSV and TSV records (RFC 4180).
+ *
+ * Fields are separated by a delimiter and records by `\n` or `\r\n`. A field that starts with `"`
+ * is quoted: it can contain delimiters and newlines, and `""` stands for a literal quote. The
+ * reader classifies 64 bytes at a time into bitmasks of quotes and separators, and computes which
+ * bytes are inside quotes with a prefix XOR of the quote mask, so every byte is looked at once.
+ */
+typedef struct {
+    string_view_t input;
+    string_view_arena_t* arena;
+    size_t cursor;
+    size_t block;
+    uint64_t separators;
+    uint64_t quoted;
+    char delimiter;
+} string_view_csv_reader_t;
+
+/**
+ * @brief Creates a CSV reader over a string view.
+ *
+ * @param input The whole CSV text; it must outlive the returned fields.
+ * @param delimiter The field delimiter, usually `,` or `\t`.
+ * @param arena The arena receiving the unescaped copies of fields that contain `""`, or `NULL`
+ *              to return such fields with their escapes left in place.
+ * @return A new CSV reader.
+ */
+string_view_csv_reader_t new_string_view_csv_reader(string_view_t input, char delimiter, string_view_arena_t* arena);
+
+/**
+ * @brief Reads the next record of a CSV reader.
+ *
+ * This function stores the fields of the next record in `fields`. Fields point into the input, with
+ * the enclosing quotes of quoted fields removed; only fields containing escaped quotes are copied
+ * into the arena. An empty line is a record with one empty field, and a newline at the end of the
+ * input does not produce an extra record.
+ *
+ * @param reader A pointer to the CSV reader.
+ * @param fields The output array for the fields (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `fields`.
+ * @param count A pointer where the total number of fields of the record is stored, which can exceed `capacity`.
+ * @return `true` if a record was read, `false` at the end of the input.
+ */
+bool string_view_csv_next_row(string_view_csv_reader_t* reader, string_view_t* fields, size_t capacity, size_t* count);
+
+/**
+ * Status codes returned by `string_view_http_parse_request` instead of a request length.
+ */
+typedef enum {
+    STRING_VIEW_HTTP_ERROR = -1,      /**< The request is malformed. */
+    STRING_VIEW_HTTP_INCOMPLETE = -2  /**< More bytes are needed to finish the request head. */
+} string_view_http_status_t;
+
+/**
+ * A header field of an HTTP message. Both views point into the parsed buffer.
+ */
+typedef struct {
+    string_view_t name;
+    string_view_t value;
+} string_view_http_header_t;
+
+/**
+ * The request line of an HTTP/1.x request. The views point into the parsed buffer.
+ */
+typedef struct {
+    string_view_t method;
+    string_view_t path;
+    int minor_version;
+} string_view_http_request_t;
+
+/**
+ * @brief Parses the head of an HTTP/1.x request.
+ *
+ * This function parses the request line and the header fields up to the empty line that ends them,
+ * without copying anything. Methods and header names are scanned with the token character set,
+ * and paths and values with the set of bytes that terminate them, so long fields are crossed by
+ * the vectorized charset search. Obsolete line folding is rejected.
+ *
+ * When the data arrives in pieces, call the function again on the whole buffer with `last_len` set
+ * to the length of the previous attempt: the buffer is then first checked for the end of the head
+ * starting near `last_len`, and is only parsed once it is complete.
+ *
+ * @param buffer The bytes received so far.
+ * @param last_len The length of the buffer on the previous call, or 0 on the first one.
+ * @param request A pointer where the request line is stored.
+ * @param headers The output array for the header fields.
+ * @param header_count A pointer to the capacity of `headers`, replaced by the number of header fields.
+ * @return The length of the request head, or a negative `string_view_http_status_t`. Having more header
+ *         fields than `headers` can hold is an error.
+ */
+int string_view_http_parse_request(string_view_t buffer, size_t last_len, string_view_http_request_t* request,
+                                   string_view_http_header_t* headers, size_t* header_count);
+
+/**
+ * @brief Finds a header field by name, ignoring ASCII case.
+ *
+ * Names are compared with `string_view_iequal`, so no lowercase copy is made.
+ *
+ * @param headers The header fields of a message.
+ * @param count The number of header fields.
+ * @param name The name to look for.
+ * @return A pointer to the first matching header field, or `NULL` if there is none.
+ */
+const string_view_http_header_t* string_view_http_find_header(const string_view_http_header_t* headers, size_t count,
+                                                              string_view_t name);
+
+/**
+ * @brief Checks if two string views are equal, ignoring ASCII case.
+ *
+ * This function folds the letters `A` to `Z` onto `a` to `z` inside vector registers while comparing,
+ * so it needs no lowercase copy and no locale. Other bytes, UTF-8 included, must match exactly.
+ *
+ * @param sv1 The first string view.
+ * @param sv2 The second string view.
+ * @return `true` if the string views are equal ignoring ASCII case, `false` otherwise.
+ */
+bool string_view_iequal(string_view_t sv1, string_view_t sv2);
+
+/**
+ * @brief Compares two string views lexicographically, ignoring ASCII case.
+ *
+ * This function orders the string views like `string_view_compare` would order their lowercase forms.
+ *
+ * @param sv1 The first string view.
+ * @param sv2 The second string view.
+ * @return A negative value, 0 or a positive value if `sv1` is less than, equal to or greater than `sv2`.
+ */
+int string_view_icompare(string_view_t sv1, string_view_t sv2);
+
+/**
+ * @brief Checks if a string view starts with a given prefix, ignoring ASCII case.
+ *
+ * @param sv The string view to check.
+ * @param prefix The prefix to look for.
+ * @return `true` if `sv` starts with `prefix` ignoring ASCII case, `false` otherwise.
+ */
+bool string_view_istarts_with(string_view_t sv, string_view_t prefix);
+
+/**
+ * @brief Checks if a string view ends with a given suffix, ignoring ASCII case.
+ *
+ * @param sv The string view to check.
+ * @param suffix The suffix to look for.
+ * @return `true` if `sv` ends with `suffix` ignoring ASCII case, `false` otherwise.
+ */
+bool string_view_iends_with(string_view_t sv, string_view_t suffix);
+
+/**
+ * @brief Finds the first occurrence of a substring, ignoring ASCII case.
+ *
+ * This function folds blocks of the haystack in vector registers and filters the candidate
+ * positions on the folded first and last byte of the needle, like the searcher does for short
+ * needles, before checking the rest of the needle. Longer needles use the Two-Way algorithm
+ * with folded comparisons, so the search stays linear in the haystack size.
+ *
+ * @param haystack The string view to search in.
+ * @param needle The substring to find.
+ * @param start The starting position for the search.
+ * @return The index of the first occurrence, or `STRING_VIEW_NPOS` if there is none.
+ */
+size_t string_view_ifind(string_view_t haystack, string_view_t needle, size_t start);
+
+/**
+ * A minimal perfect hash of a fixed set of keys, built with the hash-and-displace (CHD) method.
+ *
+ * The keys are spread over buckets of about five keys, and each bucket stores the pair of displacements
+ * that sends its keys to free slots of a table with exactly one slot per key. A lookup hashes the key
+ * once, reads the displacements of its bucket, reads the key index stored in the slot and compares
+ * the candidate with `string_view_equal`. The key array is referenced, not copied.
+ */
+typedef struct {
+    const string_view_t* keys;
+    uint32_t* displacements;
+    uint32_t* slots;
+    size_t count;
+    size_t bucket_count;
+    uint64_t seed;
+} string_view_mph_t;
+
+/**
+ * @brief Builds a minimal perfect hash of a set of keys.
+ *
+ * This function searches for a seed and the displacements of every bucket, largest buckets first;
+ * the work is done once, typically at start-up or at build time.
+ *
+ * @param mph A pointer to the perfect hash to build.
+ * @param keys The keys; they must be distinct and outlive the perfect hash.
+ * @param count The number of keys.
+ * @return `true` on success, `false` if the keys contain duplicates or memory cannot be allocated.
+ */
+bool string_view_mph_build(string_view_mph_t* mph, const string_view_t* keys, size_t count);
+
+/**
+ * @brief Releases the tables of a perfect hash.
+ *
+ * @param mph A pointer to the perfect hash.
+ */
+void string_view_mph_free(string_view_mph_t* mph);
+
+/**
+ * @brief Looks up a key in a perfect hash.
+ *
+ * @param mph A pointer to the perfect hash.
+ * @param key The key to look for.
+ * @return The index of the key in the array passed to `string_view_mph_build`, or `STRING_VIEW_NPOS`.
+ */
+size_t string_view_mph_lookup(const string_view_mph_t* mph, string_view_t key);
+
+/**
+ * @brief Emits a perfect hash as C source.
+ *
+ * This function writes the keys, the displacements, the slots and a `static inline size_t
+ * <name>_lookup(string_view_t key)` function that behaves like `string_view_mph_lookup`, so a
+ * keyword table can be generated at build time and included next to this header. The generated
+ * code calls `string_view_hash`, whose values depend on the byte order, so it must be generated
+ * on a machine with the same endianness as the target.
+ *
+ * @param mph A pointer to the perfect hash.
+ * @param out The stream to write to.
+ * @param name The prefix of the generated identifiers.
+ * @return `true` on success, `false` if writing failed.
+ */
+bool string_view_mph_write_header(const string_view_mph_t* mph, FILE* out, const char* name);
+
+struct string_view__art_node;
+
+/**
+ * An adaptive radix tree (ART) mapping string views to 64-bit values.
+ *
+ * Each inner node stores the compressed path leading to it and picks the smallest of four layouts
+ * for its children: 4 or 16 sorted key bytes (the latter searched with one SIMD compare), a 256-entry
+ * index into 48 children, or 256 direct children. A key may be a prefix of another key; the value of
+ * such a key lives in the node where it ends. Keys are not copied and must outlive the tree.
+ */
+typedef struct {
+    struct string_view__art_node* root;
+    size_t size;
+} string_view_art_t;
+
+/**
+ * The callback used by `string_view_art_iterate_prefix`. Returning `false` stops the iteration.
+ */
+typedef bool (*string_view_art_visit_fn)(void* context, string_view_t key, uint64_t value);
+
+/**
+ * @brief Initializes an empty radix tree.
+ *
+ * @param tree A pointer to the radix tree.
+ */
+void string_view_art_init(string_view_art_t* tree);
+
+/**
+ * @brief Releases the nodes of a radix tree.
+ *
+ * @param tree A pointer to the radix tree.
+ */
+void string_view_art_free(string_view_art_t* tree);
+
+/**
+ * @brief Inserts a key in a radix tree or replaces its value.
+ *
+ * @param tree A pointer to the radix tree.
+ * @param key The key; it must outlive the tree.
+ * @param value The value to associate with the key.
+ * @return `true` on success, `false` if memory cannot be allocated.
+ */
+bool string_view_art_insert(string_view_art_t* tree, string_view_t key, uint64_t value);
+
+/**
+ * @brief Looks up a key in a radix tree.
+ *
+ * @param tree A pointer to the radix tree.
+ * @param key The key to look for.
+ * @param value A pointer where the value is stored if the key is found (can be `NULL`).
+ * @return `true` if the key is present, `false` otherwise.
+ */
+bool string_view_art_lookup(const string_view_art_t* tree, string_view_t key, uint64_t* value);
+
+/**
+ * @brief Finds the longest key of a radix tree that is a prefix of a string view.
+ *
+ * This function walks the tree once along `sv`, so its cost depends on the length of `sv` and not on
+ * the number of keys, which makes it suitable for routing tables.
+ *
+ * @param tree A pointer to the radix tree.
+ * @param sv The string view to match.
+ * @param length A pointer where the length of the matching key is stored (can be `NULL`).
+ * @param value A pointer where the value of the matching key is stored (can be `NULL`).
+ * @return `true` if a key is a prefix of `sv`, `false` otherwise.
+ */
+bool string_view_art_longest_prefix(const string_view_art_t* tree, string_view_t sv, size_t* length, uint64_t* value);
+
+/**
+ * @brief Visits the keys of a radix tree that start with a prefix, in lexicographic byte order.
+ *
+ * The key passed to the callback is rebuilt in a temporary buffer that is only valid during the call.
+ *
+ * @param tree A pointer to the radix tree.
+ * @param prefix The prefix of the keys to visit; an empty prefix visits the whole tree.
+ * @param visit The callback invoked for every key.
+ * @param context A pointer passed to the callback.
+ * @return `true` if every key was visited, `false` if the callback stopped the iteration or memory ran out.
+ */
+bool string_view_art_iterate_prefix(const string_view_art_t* tree, string_view_t prefix, string_view_art_visit_fn visit, void* context);
+
+/**
+ * @brief Builds a radix tree from sorted keys.
+ *
+ * This function creates every node directly with its final layout, without the node growth of
+ * repeated insertions. The tree must be empty.
+ *
+ * @param tree A pointer to an empty radix tree.
+ * @param keys The keys, sorted as by `string_view_compare` and distinct; they must outlive the tree.
+ * @param values The values of the keys.
+ * @param count The number of keys.
+ * @return `true` on success, `false` if the keys are not sorted and distinct or memory cannot be allocated.
+ */
+bool string_view_art_bulk_load(string_view_art_t* tree, const string_view_t* keys, const uint64_t* values, size_t count);
+
+/**
+ * A suffix array index over an immutable string view.
+ *
+ * `suffixes` lists the starting positions of the suffixes of the text in lexicographic byte order and
+ * `lcp[i]` is the length of the longest common prefix of the suffixes at ranks `i - 1` and `i` (`lcp[0]`
+ * is 0). The occurrences of a pattern are the suffixes of one contiguous range of ranks, found with two
+ * binary searches. The text is not copied and must outlive the index; texts are limited to 4 GiB - 2 bytes.
+ */
+typedef struct {
+    string_view_t text;
+    const uint32_t* suffixes;
+    const uint32_t* lcp;
+    void* storage;
+    size_t storage_size;
+    bool mapped;
+} string_view_suffix_array_t;
+
+/**
+ * @brief Builds the suffix array and the LCP array of a text.
+ *
+ * This function sorts the suffixes with the SA-IS algorithm, in linear time, then computes the LCP
+ * array with Kasai's algorithm. Both arrays take 4 bytes per byte of text.
+ *
+ * @param index A pointer to the index to build.
+ * @param text The text to index; it must outlive the index.
+ * @return `true` on success, `false` if the text is too large or memory cannot be allocated.
+ */
+bool string_view_suffix_array_build(string_view_suffix_array_t* index, string_view_t text);
+
+/**
+ * @brief Releases a suffix array index, whether it was built or loaded.
+ *
+ * @param index A pointer to the index.
+ */
+void string_view_suffix_array_free(string_view_suffix_array_t* index);
+
+/**
+ * @brief Writes a suffix array index to a file.
+ *
+ * The file holds a header with the text length and hash, followed by the suffix and LCP arrays in
+ * the byte order of the machine. The text itself is not written.
+ *
+ * @param index A pointer to the index.
+ * @param path The path of the file to create.
+ * @return `true` on success, `false` if the file cannot be written.
+ */
+bool string_view_suffix_array_save(const string_view_suffix_array_t* index, const char* path);
+
+/**
+ * @brief Loads a suffix array index written by `string_view_suffix_array_save`.
+ *
+ * Where memory mapping is available the arrays are used in place from a read-only mapping of the
+ * file, so loading costs no copy; otherwise the file is read into memory. The text must be the one
+ * the index was built from, which is checked with its length and hash.
+ *
+ * @param index A pointer to the index to load.
+ * @param path The path of the file.
+ * @param text The indexed text; it must outlive the index.
+ * @return `true` on success, `false` if the file cannot be read or does not match the text.
+ */
+bool string_view_suffix_array_load(string_view_suffix_array_t* index, const char* path, string_view_t text);
+
+/**
+ * @brief Counts the (possibly overlapping) occurrences of a pattern.
+ *
+ * This function runs in O(m log n) for a pattern of length m, whatever the number of occurrences.
+ *
+ * @param index A pointer to the index.
+ * @param pattern The substring to count.
+ * @return The number of occurrences; an empty pattern occurs at every position, as with `string_view_searcher_find_all`.
+ */
+size_t string_view_suffix_array_count(const string_view_suffix_array_t* index, string_view_t pattern);
+
+/**
+ * @brief Checks if a pattern occurs in the indexed text.
+ *
+ * @param index A pointer to the index.
+ * @param pattern The substring to look for.
+ * @return `true` if the pattern occurs, `false` otherwise.
+ */
+bool string_view_suffix_array_contains(const string_view_suffix_array_t* index, string_view_t pattern);
+
+/**
+ * @brief Collects the positions of the occurrences of a pattern.
+ *
+ * The positions are stored in suffix order, not in text order.
+ *
+ * @param index A pointer to the index.
+ * @param pattern The substring to find.
+ * @param positions The output array for the positions (can be `NULL` if `capacity` is 0).
+ * @param capacity The number of elements available in `positions`.
+ * @return The total number of occurrences.
+ */
+size_t string_view_suffix_array_locate_all(const string_view_suffix_array_t* index, string_view_t pattern,
+                                           size_t* positions, size_t capacity);
+
+/**
+ * An approximate occurrence found by `string_view_fuzzy_find`.
+ */
+typedef struct {
+    size_t offset;
+    size_t count;
+    size_t distance;
+} string_view_fuzzy_match_t;
+
+/**
+ * @brief Computes the Levenshtein distance between two string views.
+ *
+ * This function uses the bit-parallel algorithm of Myers and Hyyrö, which processes 64 cells of the
+ * dynamic programming matrix per step, with one word of state per 64 bytes of the shorter view.
+ * No memory is allocated while the shorter view is at most 512 bytes long.
+ *
+ * @param sv1 The first string view.
+ * @param sv2 The second string view.
+ * @return The minimal number of byte insertions, deletions and substitutions turning `sv1` into `sv2`,
+ *         or `STRING_VIEW_NPOS` if memory cannot be allocated.
+ */
+size_t string_view_edit_distance(string_view_t sv1, string_view_t sv2);
+
+/**
+ * @brief Computes the Levenshtein distance between two string views, up to a bound.
+ *
+ * This function returns as soon as the distance is known to exceed `max_distance`, starting with
+ * views whose lengths differ by more than the bound.
+ *
+ * @param sv1 The first string view.
+ * @param sv2 The second string view.
+ * @param max_distance The largest distance of interest.
+ * @return The distance if it is at most `max_distance`, `max_distance + 1` otherwise, or
+ *         `STRING_VIEW_NPOS` if memory cannot be allocated.
+ */
+size_t string_view_edit_distance_max(string_view_t sv1, string_view_t sv2, size_t max_distance);
+
+/**
+ * @brief Finds the first approximate occurrence of a needle in a haystack.
+ *
+ * This function scans for the first position where a substring ending there is within `max_distance`
+ * edits of `needle`, moves that end forward while the distance keeps decreasing, then picks the
+ * shortest substring ending there with the smallest distance. No memory is allocated while the
+ * needle is at most 512 bytes long.
+ *
+ * @param haystack The string view to search.
+ * @param needle The string view to approximate.
+ * @param max_distance The largest number of edits allowed.
+ * @param start The index where the search starts.
+ * @param match The output for the occurrence (can be `NULL`).
+ * @return The index of the occurrence, or `STRING_VIEW_NPOS` if not found.
+ */
+size_t string_view_fuzzy_find(string_view_t haystack, string_view_t needle, size_t max_distance, size_t start,
+                              string_view_fuzzy_match_t* match);
+
+/**
+ * Instruction sets used by the vectorized routines of the library.
+ *
+ * The best level supported by the running CPU is detected on first use. Defining
+ * `STRING_VIEW_NO_SIMD` before including the implementation forces the scalar code paths.
+ */
+typedef enum {
+    STRING_VIEW_SIMD_SCALAR = 0,
+    STRING_VIEW_SIMD_SSE2,
+    STRING_VIEW_SIMD_AVX2,
+    STRING_VIEW_SIMD_AVX512
+} string_view_simd_t;
+
+/**
+ * @brief Returns the instruction set currently used by the vectorized routines.
+ *
+ * @return The active SIMD level.
+ */
+string_view_simd_t string_view_simd_level(void);
+
+/**
+ * @brief Selects the instruction set used by the vectorized routines.
+ *
+ * This function lowers (or restores) the SIMD level used by the library. The requested level is
+ * clamped to the best level supported by the running CPU, so it is always safe to call.
+ * It is mostly useful for benchmarking and testing the different code paths.
+ *
+ * @param level The desired SIMD level.
+ * @return The SIMD level that is actually in use after the call.
+ */
+string_view_simd_t string_view_set_simd_level(string_view_simd_t level);
+
+#if defined(__STDC__) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+
+/**
+ * @brief Checks if a string view contains a specified element.
+ *
+ * This macro provides a generic way to check if a string view contains either a character or a substring.
+ * The appropriate function (`string_view_find_char` or `string_view_find_substring`) is selected based on the type of the `needle` argument.
+ *
+ * @param haystack The string view to search.
+ * @param needle The element to find (can be a character or a substring).
+ * @return `true` if the element is found within the haystack, `false` otherwise.
+ */
+#define string_view_contains(haystack, needle)                          \
+    (_Generic((needle),                                                 \
+              int : string_view_find_char,                              \
+              string_view_t : string_view_find_substring)(sv, needle, 0) != STRING_VIEW_NPOS)
+#else
+
+/**
+ * @brief Checks if a string view contains a specific character.
+ *
+ * This macro is a convenience wrapper around `string_view_find_char` to determine if a character exists within a string view.
+ * It returns `true` if the character is found, otherwise `false`.
+ *
+ * @param haystack The string view to search.
+ * @param needle The character to find.
+ * @return `true` if the character is found, `false` otherwise.
+ */
+#define string_view_contains_char(haystack, needle) \
+    (string_view_find_char(haystack, needle, 0) != STRING_VIEW_NPOS)
+
+/**
+ * @brief Checks if a string view contains a specific substring.
+ *
+ * This macro is a convenience wrapper around `string_view_find_substring` to determine if a substring exists within a string view.
+ * It returns `true` if the substring is found, otherwise `false`.
+ *
+ * @param haystack The string view to search.
+ * @param needle The substring to find.
+ * @return `true` if the substring is found, `false` otherwise.
+ */
+#define string_view_contains_substring(haystack, needle) \
+    (string_view_find_substring(haystack, needle, 0) != STRING_VIEW_NPOS)
+
+#endif
+
+#endif
+
+#ifdef STRING_VIEW_IMPLEMENTATION
+
+#include <float.h>
+#include <string.h>
+
+#ifndef STRING_VIEW_MALLOC
+#include <stdlib.h>
+#define STRING_VIEW_MALLOC(size) malloc(size)
+#define STRING_VIEW_CALLOC(count, size) calloc(count, size)
+#define STRING_VIEW_REALLOC(ptr, size) realloc(ptr, size)
+#define STRING_VIEW_FREE(ptr) free(ptr)
+#endif
+
+#ifdef STRING_VIEW_HAS_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef STRING_VIEW_HAS_THREADS
+#include <pthread.h>
+#endif
+
+#if !defined(STRING_VIEW_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define STRING_VIEW__X86 1
+#include <immintrin.h>
+
+#define STRING_VIEW__TARGET_SSE2 __attribute__((target("sse2")))
+#define STRING_VIEW__TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#define STRING_VIEW__TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,bmi,bmi2,popcnt")))
+#endif
+
+#ifdef STRING_VIEW_HAS_ATOMICS
+#define STRING_VIEW__LOAD_RELAXED(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define STRING_VIEW__STORE_RELAXED(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+#define STRING_VIEW__LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define STRING_VIEW__FETCH_ADD(ptr, value) __atomic_fetch_add((ptr), (value), __ATOMIC_ACQ_REL)
+#define STRING_VIEW__FETCH_SUB(ptr, value) __atomic_fetch_sub((ptr), (value), __ATOMIC_ACQ_REL)
+#define STRING_VIEW__CAS(ptr, expected, desired) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+#define STRING_VIEW__LOAD_RELAXED(ptr) (*(ptr))
+#define STRING_VIEW__STORE_RELAXED(ptr, value) (*(ptr) = (value))
+#endif
+
+/* Bit scans; the argument must not be 0. */
+static inline int string_view__clz64(uint64_t x){
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while(!(x & (1ULL << 63))){
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static inline int string_view__ctz32(uint32_t x){
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(x);
+#else
+    int n = 0;
+    while(!(x & 1)){
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static inline int string_view__ctz64(uint64_t x){
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while(!(x & 1)){
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+#define STRING_VIEW__FILTER_MAX 32
+
+static int string_view__cpu_level = -1;
+static int string_view__active_level = -1;
+
+static int string_view__detect_simd(void){
+#ifdef STRING_VIEW__X86
+    __builtin_cpu_init();
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi")
+        && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("popcnt");
+
+    if(avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return STRING_VIEW_SIMD_AVX512;
+    }
+    if(avx2) return STRING_VIEW_SIMD_AVX2;
+    if(__builtin_cpu_supports("sse2")) return STRING_VIEW_SIMD_SSE2;
+#endif
+    return STRING_VIEW_SIMD_SCALAR;
+}
+
+static inline int string_view__simd(void){
+    int level = STRING_VIEW__LOAD_RELAXED(&string_view__active_level);
+
+    if(level < 0){
+        level = string_view__detect_simd();
+        STRING_VIEW__STORE_RELAXED(&string_view__cpu_level, level);
+        STRING_VIEW__STORE_RELAXED(&string_view__active_level, level);
+    }
+
+    return level;
+}
+
+string_view_simd_t string_view_simd_level(void){
+    return (string_view_simd_t)string_view__simd();
+}
+
+string_view_simd_t string_view_set_simd_level(string_view_simd_t level){
+    string_view__simd();
+
+    const int supported = STRING_VIEW__LOAD_RELAXED(&string_view__cpu_level);
+    const int active = ((int)level > supported) ? supported : (int)level;
+
+    STRING_VIEW__STORE_RELAXED(&string_view__active_level, active);
+    return (string_view_simd_t)active;
+}
+
+inline string_view_t new_string_view(const char* data, size_t size){
+    return (string_view_t) {
+        .data = data,
+        .count = size
+    };
+}
+
+inline string_view_t new_string_view_from_cstr(const char* data){
+    return new_string_view(data, strlen(data));
+}
+
+inline char string_view_at(string_view_t sv, size_t index){
+    return index < sv.count
+        ? sv.data[index]
+        : '\0';
+}
+
+inline char string_view_front(string_view_t sv){    
+    return string_view_at(sv, 0);
+}
+
+inline char string_view_back(string_view_t sv){
+    return string_view_at(sv, string_view_size(sv) - 1);
+}
+
+inline const char* string_view_data(string_view_t sv){
+    return sv.data;
+}
+
+inline size_t string_view_size(string_view_t sv){
+    return sv.count;
+}
+
+inline bool string_view_is_empty(string_view_t sv){
+    return sv.count == 0;
+}
+
+/* Space, tab, newline, vertical tab, form feed and carriage return, as in the "C" locale. */
+static const string_view_charset_t string_view__whitespace = {
+    { (1ULL << ' ') | 0x3E00ULL, 0, 0, 0 },
+    { 0x04, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x01, 0x01, 0x01, 0x01, 0, 0 },
+    { 0 },
+    { ' ', '\t', '\n', '\v', '\f', '\r' },
+    6
+};
+
+void string_view_trim_left(string_view_t *sv) {
+    const size_t first = string_view_find_first_not_of(*sv, &string_view__whitespace, 0);
+    const size_t count = (first == STRING_VIEW_NPOS) ? sv->count : first;
+
+    sv->data += count;
+    sv->count -= count;
+}
+
+void string_view_trim_right(string_view_t *sv) {
+    const size_t last = string_view_find_last_not_of(*sv, &string_view__whitespace, STRING_VIEW_NPOS);
+    sv->count = (last == STRING_VIEW_NPOS) ? 0 : last + 1;
+}
+
+inline void string_view_trim(string_view_t *sv){
+    string_view_trim_left(sv);
+    string_view_trim_right(sv);
+}
+
+void string_view_remove_prefix(string_view_t *sv, size_t n){
+    if(n > sv->count){
+        *sv = STRING_VIEW_EMPTY;
+    }else{
+        sv->data += n;
+        sv->count -= n;
+    }
+}
+
+inline void string_view_remove_suffix(string_view_t *sv, size_t n){
+    sv->count -= (n > sv->count)
+        ? sv->count
+        : n;
+}
+
+void string_view_swap(string_view_t* sv1, string_view_t* sv2){
+    string_view_t tmp = *sv1;
+    *sv1 = *sv2;
+    *sv2 = tmp;
+}
+
+void string_view_copy(string_view_t sv, char *dest, size_t count, size_t start){
+
+    if(dest == NULL || start >= sv.count) return;
+    if(sv.count - start < count) {
+        count = sv.count - start;
+    }
+
+    memcpy(dest, &sv.data[start], count);
+}
+
+string_view_t string_view_substr(string_view_t sv, size_t start, size_t count){  
+    if(count > (sv.count - start)) {
+        count = sv.count - start;
+    }
+
+    return (start < sv.count) 
+        ? new_string_view(&sv.data[start], count)
+        : STRING_VIEW_EMPTY;
+}
+
+int string_view_compare(const string_view_t sv1, const string_view_t sv2){
+    const size_t count = (sv1.count < sv2.count) ? sv1.count : sv2.count;
+    const int order = (count > 0) ? memcmp(sv1.data, sv2.data, count) : 0;
+
+    if(order != 0) return order;
+    return (sv1.count > sv2.count) - (sv1.count < sv2.count);
+}
+
+inline bool string_view_equal(string_view_t sv1, string_view_t sv2){
+    return sv1.count == sv2.count && (sv1.count == 0 || memcmp(sv1.data, sv2.data, sv1.count) == 0);
+}
+
+inline bool string_view_starts_with(string_view_t sv, string_view_t prefix){
+    if(prefix.count > sv.count) return false;
+    return prefix.count == 0 || memcmp(sv.data, prefix.data, prefix.count) == 0;
+}
+
+bool string_view_ends_with(string_view_t sv, string_view_t suffix){
+    
+    if(suffix.count > sv.count) return false;
+
+    const size_t pos = sv.count - suffix.count;
+    return suffix.count == 0 || memcmp(&sv.data[pos], suffix.data, suffix.count) == 0;
+}
+
+#define STRING_VIEW__SORT_INSERTION 16
+
+typedef struct {
+    uint64_t prefix;
+    string_view_t view;
+} string_view__sort_item_t;
+
+/* Loads the 8 bytes of `sv` starting at `depth` as a big-endian integer, padded with zeros. */
+static inline uint64_t string_view__sort_prefix(string_view_t sv, size_t depth){
+    const size_t rest = sv.count - depth;
+    uint64_t prefix = 0;
+
+    if(rest >= 8){
+        memcpy(&prefix, sv.data + depth, 8);
+    }else if(rest > 0){
+        memcpy(&prefix, sv.data + depth, rest);
+    }
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return prefix;
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(prefix);
+#else
+    unsigned char bytes[8];
+    uint64_t ordered = 0;
+
+    memcpy(bytes, &prefix, sizeof(bytes));
+    for(size_t i = 0; i < 8; i++) ordered = (ordered << 8) | bytes[i];
+    return ordered;
+#endif
+}
+
+/* Orders two items on their cached prefix, then on how many of its 8 bytes are real characters. */
+static inline int string_view__sort_key_compare(const string_view__sort_item_t* a, const string_view__sort_item_t* b,
+                                                size_t depth){
+    if(a->prefix != b->prefix) return (a->prefix < b->prefix) ? -1 : 1;
+
+    const size_t ra = (a->view.count - depth < 8) ? a->view.count - depth : 8;
+    const size_t rb = (b->view.count - depth < 8) ? b->view.count - depth : 8;
+    return (ra > rb) - (ra < rb);
+}
+
+static void string_view__sort_insertion(string_view__sort_item_t* items, size_t count, size_t depth){
+    for(size_t i = 1; i < count; i++){
+        const string_view__sort_item_t item = items[i];
+        const string_view_t rest = new_string_view(item.view.data + depth, item.view.count - depth);
+        size_t j = i;
+
+        while(j > 0){
+            int order = string_view__sort_key_compare(&items[j - 1], &item, depth);
+            if(order == 0){
+                const string_view_t other = new_string_view(items[j - 1].view.data + depth, items[j - 1].view.count - depth);
+                order = string_view_compare(other, rest);
+            }
+            if(order <= 0) break;
+
+            items[j] = items[j - 1];
+            j--;
+        }
+        items[j] = item;
+    }
+}
+
+static inline void string_view__sort_swap(string_view__sort_item_t* a, string_view__sort_item_t* b){
+    const string_view__sort_item_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+static void string_view__sort_multikey(string_view__sort_item_t* items, size_t count, size_t depth){
+    while(count > STRING_VIEW__SORT_INSERTION){
+        string_view__sort_item_t* a = &items[0];
+        string_view__sort_item_t* b = &items[count / 2];
+        string_view__sort_item_t* c = &items[count - 1];
+
+        /* Median of three as the pivot, moved to the front. */
+        if(string_view__sort_key_compare(a, b, depth) > 0) string_view__sort_swap(a, b);
+        if(string_view__sort_key_compare(b, c, depth) > 0) string_view__sort_swap(b, c);
+        if(string_view__sort_key_compare(a, b, depth) > 0) string_view__sort_swap(a, b);
+        string_view__sort_swap(&items[0], b);
+
+        /* Three-way partition: [0, lt) < pivot, [lt, i) == pivot, [gt, count) > pivot. */
+        const string_view__sort_item_t pivot = items[0];
+        size_t lt = 0, i = 1, gt = count;
+        while(i < gt){
+            const int order = string_view__sort_key_compare(&items[i], &pivot, depth);
+            if(order < 0) string_view__sort_swap(&items[lt++], &items[i++]);
+            else if(order > 0) string_view__sort_swap(&items[i], &items[--gt]);
+            else i++;
+        }
+
+        /*
+         * The equal keys share 8 more bytes: they continue on the next 8 unless they ended here.
+         * Only partitions smaller than the one kept in this loop are sorted recursively, which
+         * bounds the recursion depth by log2(count) whatever the input.
+         */
+        const size_t less = lt, greater = count - gt;
+        const size_t equal = (pivot.view.count - depth < 8) ? 0 : gt - lt;
+
+        if(equal >= less && equal >= greater){
+            string_view__sort_multikey(items, less, depth);
+            string_view__sort_multikey(items + gt, greater, depth);
+            items += lt;
+            count = equal;
+            depth += 8;
+            for(size_t k = 0; k < count; k++) items[k].prefix = string_view__sort_prefix(items[k].view, depth);
+            continue;
+        }
+
+        if(equal > 0){
+            for(size_t k = lt; k < gt; k++) items[k].prefix = string_view__sort_prefix(items[k].view, depth + 8);
+            string_view__sort_multikey(items + lt, equal, depth + 8);
+        }
+
+        if(less >= greater){
+            string_view__sort_multikey(items + gt, greater, depth);
+            count = less;
+        }else{
+            string_view__sort_multikey(items, less, depth);
+            items += gt;
+            count = greater;
+        }
+    }
+
+    string_view__sort_insertion(items, count, depth);
+}
+
+/* Allocation-free fallback: heapsort on the views themselves. */
+static void string_view__sort_heap(string_view_t* views, size_t count){
+    for(size_t end = count, start = count / 2; end > 1;){
+        size_t root;
+
+        if(start > 0){
+            root = --start;
+        }else{
+            const string_view_t tmp = views[0];
+            views[0] = views[--end];
+            views[end] = tmp;
+            root = 0;
+        }
+
+        for(size_t child; (child = 2 * root + 1) < end; root = child){
+            if(child + 1 < end && string_view_compare(views[child], views[child + 1]) < 0) child++;
+            if(string_view_compare(views[root], views[child]) >= 0) break;
+
+            const string_view_t tmp = views[root];
+            views[root] = views[child];
+            views[child] = tmp;
+        }
+    }
+}
+
+void string_view_sort(string_view_t* views, size_t count){
+    if(count < 2) return;
+
+    string_view__sort_item_t* items = (count <= SIZE_MAX / sizeof(*items)) ? STRING_VIEW_MALLOC(count * sizeof(*items)) : NULL;
+    if(items == NULL){
+        string_view__sort_heap(views, count);
+        return;
+    }
+
+    for(size_t i = 0; i < count; i++){
+        items[i].prefix = string_view__sort_prefix(views[i], 0);
+        items[i].view = views[i];
+    }
+
+    string_view__sort_multikey(items, count, 0);
+
+    for(size_t i = 0; i < count; i++) views[i] = items[i].view;
+    STRING_VIEW_FREE(items);
+}
+
+static size_t string_view__find_char_scalar(const char* s, size_t n, char c){
+    const char* found = (n > 0) ? memchr(s, c, n) : NULL;
+    return (found != NULL) ? (size_t)(found - s) : STRING_VIEW_NPOS;
+}
+
+static size_t string_view__rfind_char_scalar(const char* s, size_t n, char c){
+    while(n > 0){
+        if(s[--n] == c) return n;
+    }
+    return STRING_VIEW_NPOS;
+}
+
+static size_t string_view__count_char_scalar(const char* s, size_t n, char c){
+    size_t total = 0;
+    for(size_t i = 0; i < n; i++){
+        total += (s[i] == c);
+    }
+    return total;
+}
+
+#ifdef STRING_VIEW__X86
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__find_char_sse2(const char* s, size_t n, char c){
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16){
+        const __m128i block = _mm_loadu_si128((const __m128i*)(s + i));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if(mask != 0) return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    const size_t tail = string_view__find_char_scalar(s + i, n - i, c);
+    return (tail != STRING_VIEW_NPOS) ? i + tail : STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__rfind_char_sse2(const char* s, size_t n, char c){
+    const __m128i needle = _mm_set1_epi8(c);
+
+    while(n >= 16){
+        const __m128i block = _mm_loadu_si128((const __m128i*)(s + n - 16));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if(mask != 0) return n - 16 + (size_t)(31 - __builtin_clz((unsigned)mask));
+        n -= 16;
+    }
+
+    return string_view__rfind_char_scalar(s, n, c);
+}
+
+/*
+ * The counting kernels subtract the 0xFF compare results from per-byte counters, which can absorb
+ * 255 blocks before overflowing, then fold the counters into 64-bit sums with a sum of absolute
+ * differences against zero. There is no branch or popcount per block.
+ */
+#define STRING_VIEW__COUNT_BLOCKS 255
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__count_char_sse2(const char* s, size_t n, char c){
+    const __m128i needle = _mm_set1_epi8(c);
+    __m128i sums = _mm_setzero_si128();
+    uint64_t lanes[2];
+    size_t i = 0;
+
+    while(n - i >= 16){
+        const size_t blocks = ((n - i) / 16 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 16 : STRING_VIEW__COUNT_BLOCKS;
+        __m128i counters = _mm_setzero_si128();
+
+        for(size_t b = 0; b < blocks; b++, i += 16){
+            const __m128i block = _mm_loadu_si128((const __m128i*)(s + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(block, needle));
+        }
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(counters, _mm_setzero_si128()));
+    }
+
+    _mm_storeu_si128((__m128i*)lanes, sums);
+    return (size_t)(lanes[0] + lanes[1]) + string_view__count_char_scalar(s + i, n - i, c);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__find_char_avx2(const char* s, size_t n, char c){
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+
+    for(; i + 64 <= n; i += 64){
+        const __m256i eq0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(s + i)), needle);
+        const __m256i eq1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(s + i + 32)), needle);
+
+        if(!_mm256_testz_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq0, eq1))){
+            const uint64_t mask = (uint32_t)_mm256_movemask_epi8(eq0)
+                | ((uint64_t)(uint32_t)_mm256_movemask_epi8(eq1) << 32);
+            return i + (size_t)_tzcnt_u64(mask);
+        }
+    }
+
+    for(; i + 32 <= n; i += 32){
+        const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(s + i)), needle);
+        const uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq);
+        if(mask != 0) return i + (size_t)_tzcnt_u32(mask);
+    }
+
+    const size_t tail = string_view__find_char_sse2(s + i, n - i, c);
+    return (tail != STRING_VIEW_NPOS) ? i + tail : STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__rfind_char_avx2(const char* s, size_t n, char c){
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    while(n >= 32){
+        const __m256i eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(s + n - 32)), needle);
+        const uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq);
+        if(mask != 0) return n - 32 + (size_t)(31 - __builtin_clz(mask));
+        n -= 32;
+    }
+
+    return string_view__rfind_char_sse2(s, n, c);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__count_char_avx2(const char* s, size_t n, char c){
+    const __m256i needle = _mm256_set1_epi8(c);
+    __m256i sums = _mm256_setzero_si256();
+    uint64_t lanes[4];
+    size_t i = 0;
+
+    while(n - i >= 32){
+        const size_t blocks = ((n - i) / 32 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 32 : STRING_VIEW__COUNT_BLOCKS;
+        __m256i counters = _mm256_setzero_si256();
+
+        for(size_t b = 0; b < blocks; b++, i += 32){
+            const __m256i block = _mm256_loadu_si256((const __m256i*)(s + i));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(block, needle));
+        }
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, sums);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + string_view__count_char_sse2(s + i, n - i, c);
+}
+
+STRING_VIEW__TARGET_AVX512
+static inline __mmask64 string_view__tail_mask64(size_t n){
+    return (n >= 64) ? ~(__mmask64)0 : (__mmask64)_bzhi_u64(~0ULL, (unsigned)n);
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__find_char_avx512(const char* s, size_t n, char c){
+    const __m512i needle = _mm512_set1_epi8(c);
+    size_t i = 0;
+
+    for(; i + 64 <= n; i += 64){
+        const __mmask64 mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(s + i)), needle);
+        if(mask != 0) return i + (size_t)_tzcnt_u64(mask);
+    }
+
+    if(i < n){
+        const __mmask64 valid = string_view__tail_mask64(n - i);
+        const __m512i block = _mm512_maskz_loadu_epi8(valid, s + i);
+        const __mmask64 mask = _mm512_mask_cmpeq_epi8_mask(valid, block, needle);
+        if(mask != 0) return i + (size_t)_tzcnt_u64(mask);
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__rfind_char_avx512(const char* s, size_t n, char c){
+    const __m512i needle = _mm512_set1_epi8(c);
+
+    while(n >= 64){
+        const __mmask64 mask = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(s + n - 64)), needle);
+        if(mask != 0) return n - 64 + (size_t)(63 - __builtin_clzll(mask));
+        n -= 64;
+    }
+
+    if(n > 0){
+        const __mmask64 valid = string_view__tail_mask64(n);
+        const __m512i block = _mm512_maskz_loadu_epi8(valid, s);
+        const __mmask64 mask = _mm512_mask_cmpeq_epi8_mask(valid, block, needle);
+        if(mask != 0) return (size_t)(63 - __builtin_clzll(mask));
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__count_char_avx512(const char* s, size_t n, char c){
+    const __m512i needle = _mm512_set1_epi8(c);
+    __m512i sums = _mm512_setzero_si512();
+    size_t total = 0;
+    size_t i = 0;
+
+    while(n - i >= 64){
+        const size_t blocks = ((n - i) / 64 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 64 : STRING_VIEW__COUNT_BLOCKS;
+        __m512i counters = _mm512_setzero_si512();
+
+        for(size_t b = 0; b < blocks; b++, i += 64){
+            const __mmask64 eq = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)(s + i)), needle);
+            counters = _mm512_sub_epi8(counters, _mm512_movm_epi8(eq));
+        }
+        sums = _mm512_add_epi64(sums, _mm512_sad_epu8(counters, _mm512_setzero_si512()));
+    }
+
+    if(i < n){
+        const __mmask64 valid = string_view__tail_mask64(n - i);
+        const __m512i block = _mm512_maskz_loadu_epi8(valid, s + i);
+        total += (size_t)_mm_popcnt_u64(_mm512_mask_cmpeq_epi8_mask(valid, block, needle));
+    }
+
+    return total + (size_t)_mm512_reduce_add_epi64(sums);
+}
+
+#endif
+
+static size_t string_view__find_char(const char* s, size_t n, char c){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__find_char_avx512(s, n, c);
+    case STRING_VIEW_SIMD_AVX2: return string_view__find_char_avx2(s, n, c);
+    case STRING_VIEW_SIMD_SSE2: return string_view__find_char_sse2(s, n, c);
+#endif
+    default: return string_view__find_char_scalar(s, n, c);
+    }
+}
+
+static size_t string_view__rfind_char(const char* s, size_t n, char c){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__rfind_char_avx512(s, n, c);
+    case STRING_VIEW_SIMD_AVX2: return string_view__rfind_char_avx2(s, n, c);
+    case STRING_VIEW_SIMD_SSE2: return string_view__rfind_char_sse2(s, n, c);
+#endif
+    default: return string_view__rfind_char_scalar(s, n, c);
+    }
+}
+
+static size_t string_view__count_char(const char* s, size_t n, char c){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__count_char_avx512(s, n, c);
+    case STRING_VIEW_SIMD_AVX2: return string_view__count_char_avx2(s, n, c);
+    case STRING_VIEW_SIMD_SSE2: return string_view__count_char_sse2(s, n, c);
+#endif
+    default: return string_view__count_char_scalar(s, n, c);
+    }
+}
+
+size_t string_view_find_char(string_view_t sv, char c, size_t start){
+
+    if(start >= sv.count) return STRING_VIEW_NPOS;
+
+    const size_t pos = string_view__find_char(&sv.data[start], sv.count - start, c);
+    return (pos != STRING_VIEW_NPOS) ? start + pos : STRING_VIEW_NPOS;
+}
+
+size_t string_view_rfind_char(string_view_t sv, char c, size_t start){
+
+    if(sv.count == 0) return STRING_VIEW_NPOS;
+
+    const size_t end = (start < sv.count) ? start + 1 : sv.count;
+    return string_view__rfind_char(sv.data, end, c);
+}
+
+size_t string_view_count_char(string_view_t sv, char c){
+    return string_view__count_char(sv.data, sv.count, c);
+}
+
+size_t string_view_count_lines(string_view_t sv){
+    if(sv.count == 0) return 0;
+    return string_view__count_char(sv.data, sv.count, '\n') + (sv.data[sv.count - 1] != '\n');
+}
+
+typedef struct {
+    size_t* positions;
+    size_t capacity;
+    size_t found;
+    size_t limit;
+} string_view__matches_t;
+
+static inline bool string_view__matches_push(string_view__matches_t* matches, size_t position){
+    if(matches->found < matches->capacity) {
+        matches->positions[matches->found] = position;
+    }
+    return ++matches->found >= matches->limit;
+}
+
+static void string_view__filter_scalar(const char* hay, size_t n, const char* needle, size_t m,
+                                       size_t i, string_view__matches_t* matches){
+    const char first = needle[0];
+    const char last = needle[m - 1];
+
+    while(i + m <= n){
+        const char* found = memchr(&hay[i], first, n - m + 1 - i);
+        if(found == NULL) return;
+
+        i = (size_t)(found - hay);
+        if(hay[i + m - 1] == last && memcmp(&hay[i + 1], &needle[1], m - 2) == 0
+           && string_view__matches_push(matches, i)) return;
+        i++;
+    }
+}
+
+#ifdef STRING_VIEW__X86
+
+STRING_VIEW__TARGET_SSE2
+static void string_view__filter_sse2(const char* hay, size_t n, const char* needle, size_t m,
+                                     size_t i, string_view__matches_t* matches){
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+
+    for(; i + m + 15 <= n; i += 16){
+        const __m128i eq_first = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&hay[i]), first);
+        const __m128i eq_last = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&hay[i + m - 1]), last);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)__builtin_ctz(mask);
+            if(memcmp(&hay[pos + 1], &needle[1], m - 2) == 0
+               && string_view__matches_push(matches, pos)) return;
+            mask &= mask - 1;
+        }
+    }
+
+    string_view__filter_scalar(hay, n, needle, m, i, matches);
+}
+
+STRING_VIEW__TARGET_AVX2
+static void string_view__filter_avx2(const char* hay, size_t n, const char* needle, size_t m,
+                                     size_t i, string_view__matches_t* matches){
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+
+    for(; i + m + 31 <= n; i += 32){
+        const __m256i eq_first = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&hay[i]), first);
+        const __m256i eq_last = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&hay[i + m - 1]), last);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last));
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)_tzcnt_u32(mask);
+            if(memcmp(&hay[pos + 1], &needle[1], m - 2) == 0
+               && string_view__matches_push(matches, pos)) return;
+            mask = _blsr_u32(mask);
+        }
+    }
+
+    string_view__filter_sse2(hay, n, needle, m, i, matches);
+}
+
+STRING_VIEW__TARGET_AVX512
+static void string_view__filter_avx512(const char* hay, size_t n, const char* needle, size_t m,
+                                       size_t i, string_view__matches_t* matches){
+    const __m512i first = _mm512_set1_epi8(needle[0]);
+    const __m512i last = _mm512_set1_epi8(needle[m - 1]);
+
+    for(; i + m + 63 <= n; i += 64){
+        const __mmask64 eq_first = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512((const void*)&hay[i]), first);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(eq_first, _mm512_loadu_si512((const void*)&hay[i + m - 1]), last);
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)_tzcnt_u64(mask);
+            if(memcmp(&hay[pos + 1], &needle[1], m - 2) == 0
+               && string_view__matches_push(matches, pos)) return;
+            mask = _blsr_u64(mask);
+        }
+    }
+
+    string_view__filter_avx2(hay, n, needle, m, i, matches);
+}
+
+#endif
+
+static void string_view__filter(const char* hay, size_t n, const char* needle, size_t m,
+                                size_t i, string_view__matches_t* matches){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: string_view__filter_avx512(hay, n, needle, m, i, matches); break;
+    case STRING_VIEW_SIMD_AVX2: string_view__filter_avx2(hay, n, needle, m, i, matches); break;
+    case STRING_VIEW_SIMD_SSE2: string_view__filter_sse2(hay, n, needle, m, i, matches); break;
+#endif
+    default: string_view__filter_scalar(hay, n, needle, m, i, matches); break;
+    }
+}
+
+static inline unsigned char string_view__ascii_lower(char c){
+    const unsigned char byte = (unsigned char)c;
+    return (unsigned char)(byte - 'A') < 26 ? byte | 0x20 : byte;
+}
+
+/* Returns the byte itself, or its ASCII lowercase form when the search ignores case. */
+static inline unsigned char string_view__two_way_byte(unsigned char c, bool fold){
+    return fold ? string_view__ascii_lower((char)c) : c;
+}
+
+static inline bool string_view__two_way_equal(unsigned char a, unsigned char b, bool fold){
+    return a == b || (fold && string_view__ascii_lower((char)a) == string_view__ascii_lower((char)b));
+}
+
+/* Computes the critical factorization of the needle (Crochemore-Perrin), returning the
+   index where the right half starts and storing the period of that half in `period`.
+   With `fold` set the bytes are ordered by their lowercase form. */
+static size_t string_view__critical_factorization(const unsigned char* needle, size_t m, size_t* period, bool fold){
+    size_t max_suffix = STRING_VIEW_NPOS, max_suffix_rev = STRING_VIEW_NPOS;
+    size_t j = 0, k = 1, p = 1;
+
+    if(m < 3){
+        *period = 1;
+        return m - 1;
+    }
+
+    while(j + k < m){
+        const unsigned char a = string_view__two_way_byte(needle[j + k], fold);
+        const unsigned char b = string_view__two_way_byte(needle[max_suffix + k], fold);
+
+        if(a < b){
+            j += k;
+            k = 1;
+            p = j - max_suffix;
+        }else if(a == b){
+            if(k != p) {
+                k++;
+            }else{
+                j += p;
+                k = 1;
+            }
+        }else{
+            max_suffix = j++;
+            k = p = 1;
+        }
+    }
+    *period = p;
+
+    j = 0;
+    k = p = 1;
+    while(j + k < m){
+        const unsigned char a = string_view__two_way_byte(needle[j + k], fold);
+        const unsigned char b = string_view__two_way_byte(needle[max_suffix_rev + k], fold);
+
+        if(b < a){
+            j += k;
+            k = 1;
+            p = j - max_suffix_rev;
+        }else if(a == b){
+            if(k != p) {
+                k++;
+            }else{
+                j += p;
+                k = 1;
+            }
+        }else{
+            max_suffix_rev = j++;
+            k = p = 1;
+        }
+    }
+
+    if(max_suffix_rev + 1 < max_suffix + 1) return max_suffix + 1;
+
+    *period = p;
+    return max_suffix_rev + 1;
+}
+
+static inline void string_view__two_way(const string_view_searcher_t* searcher, const unsigned char* hay, size_t n,
+                                        size_t j, bool fold, string_view__matches_t* matches){
+    const unsigned char* needle = (const unsigned char*)searcher->needle.data;
+    const size_t m = searcher->needle.count;
+    const size_t suffix = searcher->suffix;
+    const size_t period = searcher->period;
+    size_t memory = 0;
+
+    while(j + m <= n){
+        size_t shift = searcher->shift[hay[j + m - 1]];
+
+        if(shift > 0){
+            if(searcher->periodic && memory != 0 && shift < period) {
+                shift = m - period;
+            }
+            memory = 0;
+            j += shift;
+            continue;
+        }
+
+        size_t i = (suffix > memory) ? suffix : memory;
+        while(i < m - 1 && string_view__two_way_equal(needle[i], hay[i + j], fold)) i++;
+
+        if(i < m - 1){
+            j += i - suffix + 1;
+            memory = 0;
+            continue;
+        }
+
+        i = suffix;
+        while(i > memory && string_view__two_way_equal(needle[i - 1], hay[i - 1 + j], fold)) i--;
+
+        if(i <= memory && string_view__matches_push(matches, j)) return;
+
+        j += period;
+        memory = searcher->periodic ? m - period : 0;
+    }
+}
+
+/* Prepares the Two-Way state of a needle longer than one byte. With `fold` set the
+   shift table covers both cases of every letter, so the scan can index it with raw bytes. */
+static void string_view__two_way_init(string_view_searcher_t* searcher, string_view_t needle, bool fold){
+    const unsigned char* bytes = (const unsigned char*)needle.data;
+    const size_t m = needle.count;
+
+    searcher->needle = needle;
+    searcher->algorithm = STRING_VIEW_SEARCH_TWO_WAY;
+    searcher->suffix = string_view__critical_factorization(bytes, m, &searcher->period, fold);
+
+    if(fold){
+        size_t i = 0;
+        while(i < searcher->suffix && string_view__two_way_equal(bytes[i], bytes[i + searcher->period], true)) i++;
+        searcher->periodic = i == searcher->suffix;
+    }else{
+        searcher->periodic = memcmp(bytes, bytes + searcher->period, searcher->suffix) == 0;
+    }
+    if(!searcher->periodic){
+        searcher->period = ((searcher->suffix > m - searcher->suffix) ? searcher->suffix : m - searcher->suffix) + 1;
+    }
+
+    for(size_t i = 0; i < 256; i++){
+        searcher->shift[i] = m;
+    }
+    for(size_t i = 0; i < m; i++){
+        const unsigned char c = string_view__two_way_byte(bytes[i], fold);
+
+        searcher->shift[c] = m - i - 1;
+        if(fold && (unsigned char)(c - 'a') < 26) searcher->shift[c ^ 0x20] = m - i - 1;
+    }
+}
+
+static void string_view__searcher_init(string_view_searcher_t* searcher, string_view_t needle){
+    searcher->needle = needle;
+    searcher->suffix = 0;
+    searcher->period = 1;
+    searcher->periodic = false;
+
+    if(needle.count == 0){
+        searcher->algorithm = STRING_VIEW_SEARCH_EMPTY;
+        return;
+    }
+    if(needle.count == 1){
+        searcher->algorithm = STRING_VIEW_SEARCH_CHAR;
+        return;
+    }
+    if(needle.count <= STRING_VIEW__FILTER_MAX){
+        searcher->algorithm = STRING_VIEW_SEARCH_FILTER;
+        return;
+    }
+
+    string_view__two_way_init(searcher, needle, false);
+}
+
+static void string_view__searcher_scan(const string_view_searcher_t* searcher, string_view_t haystack,
+                                       size_t start, string_view__matches_t* matches){
+    const size_t m = searcher->needle.count;
+
+    if(start > haystack.count || m > haystack.count - start) return;
+
+    switch(searcher->algorithm){
+    case STRING_VIEW_SEARCH_EMPTY:
+        for(size_t i = start; i <= haystack.count; i++){
+            if(string_view__matches_push(matches, i)) return;
+        }
+        break;
+    case STRING_VIEW_SEARCH_CHAR:
+        for(size_t i = start; i < haystack.count; i++){
+            const size_t pos = string_view__find_char(&haystack.data[i], haystack.count - i, searcher->needle.data[0]);
+            if(pos == STRING_VIEW_NPOS) return;
+
+            i += pos;
+            if(string_view__matches_push(matches, i)) return;
+        }
+        break;
+    case STRING_VIEW_SEARCH_FILTER:
+        string_view__filter(haystack.data, haystack.count, searcher->needle.data, m, start, matches);
+        break;
+    case STRING_VIEW_SEARCH_TWO_WAY:
+        string_view__two_way(searcher, (const unsigned char*)haystack.data, haystack.count, start, false, matches);
+        break;
+    }
+}
+
+string_view_searcher_t new_string_view_searcher(string_view_t needle){
+    string_view_searcher_t searcher;
+    string_view__searcher_init(&searcher, needle);
+    return searcher;
+}
+
+size_t string_view_searcher_find(const string_view_searcher_t* searcher, string_view_t haystack, size_t start){
+    size_t position = STRING_VIEW_NPOS;
+    string_view__matches_t matches = { &position, 1, 0, 1 };
+
+    string_view__searcher_scan(searcher, haystack, start, &matches);
+    return position;
+}
+
+inline size_t string_view_searcher_find_next(const string_view_searcher_t* searcher, string_view_t haystack, size_t previous){
+    return string_view_searcher_find(searcher, haystack, previous + 1);
+}
+
+size_t string_view_searcher_find_all(const string_view_searcher_t* searcher, string_view_t haystack,
+                                     size_t* positions, size_t capacity){
+    string_view__matches_t matches = { positions, capacity, 0, STRING_VIEW_NPOS };
+
+    string_view__searcher_scan(searcher, haystack, 0, &matches);
+    return matches.found;
+}
+
+size_t string_view_find_substring(string_view_t haystack, string_view_t needle, size_t start){
+
+    if(needle.count > haystack.count) return STRING_VIEW_NPOS;
+    if(needle.count <= 1) {
+        if(needle.count == 0) return (start <= haystack.count) ? start : STRING_VIEW_NPOS;
+        return string_view_find_char(haystack, needle.data[0], start);
+    }
+
+    /* Short needles skip the searcher, which only carries state for the Two-Way scan. */
+    if(needle.count <= STRING_VIEW__FILTER_MAX){
+        size_t position = STRING_VIEW_NPOS;
+        string_view__matches_t matches = { &position, 1, 0, 1 };
+
+        if(start > haystack.count || needle.count > haystack.count - start) return STRING_VIEW_NPOS;
+        string_view__filter(haystack.data, haystack.count, needle.data, needle.count, start, &matches);
+        return position;
+    }
+
+    string_view_searcher_t searcher;
+    string_view__two_way_init(&searcher, needle, false);
+    return string_view_searcher_find(&searcher, haystack, start);
+}
+
+string_view_charset_t new_string_view_charset(string_view_t chars){
+    string_view_charset_t set;
+    size_t distinct = 0;
+
+    memset(&set, 0, sizeof(set));
+    for(size_t i = 0; i < chars.count; i++){
+        const uint8_t c = (uint8_t)chars.data[i];
+        if(string_view_charset_contains(&set, (char)c)) continue;
+
+        if(distinct < sizeof(set.chars)) set.chars[distinct] = c;
+        distinct++;
+        set.bits[c >> 6] |= 1ULL << (c & 63);
+        if(c < 0x80) set.low_rows[c & 15] |= (uint8_t)(1u << (c >> 4));
+        else set.high_rows[c & 15] |= (uint8_t)(1u << ((c >> 4) - 8));
+    }
+
+    set.char_count = (distinct <= sizeof(set.chars)) ? (uint8_t)distinct : 0;
+    return set;
+}
+
+string_view_charset_t new_string_view_charset_from_predicate(int (*predicate)(int)){
+    char chars[256];
+    size_t count = 0;
+
+    for(int c = 0; c < 256; c++){
+        if(predicate(c)) chars[count++] = (char)c;
+    }
+
+    return new_string_view_charset(new_string_view(chars, count));
+}
+
+inline bool string_view_charset_contains(const string_view_charset_t* set, char c){
+    const uint8_t byte = (uint8_t)c;
+    return (set->bits[byte >> 6] >> (byte & 63)) & 1;
+}
+
+/* Each `*_charset_mask64` kernel returns a 64-bit mask of the bytes of a 64-byte block that belong to the set. */
+static uint64_t string_view__charset_mask64_scalar(const char* p, const string_view_charset_t* set){
+    uint64_t mask = 0;
+    for(size_t i = 0; i < 64; i++){
+        mask |= (uint64_t)string_view_charset_contains(set, p[i]) << i;
+    }
+    return mask;
+}
+
+#ifdef STRING_VIEW__X86
+
+/* Compares the block against each listed byte of a small set, as SSE2 has no byte shuffle. */
+STRING_VIEW__TARGET_SSE2
+static uint64_t string_view__charset_mask64_sse2(const char* p, const string_view_charset_t* set){
+    const __m128i b0 = _mm_loadu_si128((const __m128i*)p);
+    const __m128i b1 = _mm_loadu_si128((const __m128i*)(p + 16));
+    const __m128i b2 = _mm_loadu_si128((const __m128i*)(p + 32));
+    const __m128i b3 = _mm_loadu_si128((const __m128i*)(p + 48));
+    __m128i m0 = _mm_setzero_si128(), m1 = m0, m2 = m0, m3 = m0;
+
+    for(size_t j = 0; j < set->char_count; j++){
+        const __m128i c = _mm_set1_epi8((char)set->chars[j]);
+        m0 = _mm_or_si128(m0, _mm_cmpeq_epi8(b0, c));
+        m1 = _mm_or_si128(m1, _mm_cmpeq_epi8(b1, c));
+        m2 = _mm_or_si128(m2, _mm_cmpeq_epi8(b2, c));
+        m3 = _mm_or_si128(m3, _mm_cmpeq_epi8(b3, c));
+    }
+
+    return (uint64_t)(uint16_t)_mm_movemask_epi8(m0)
+        | ((uint64_t)(uint16_t)_mm_movemask_epi8(m1) << 16)
+        | ((uint64_t)(uint16_t)_mm_movemask_epi8(m2) << 32)
+        | ((uint64_t)(uint16_t)_mm_movemask_epi8(m3) << 48);
+}
+
+/*
+ * Nibble-shuffle classification: the low nibble of each byte selects a row of 8 bits in both
+ * tables, and the high nibble selects the bit of that row. Bit 7 of the shuffle index zeroes the
+ * lookup, so each table only answers for its own half of the byte values.
+ */
+STRING_VIEW__TARGET_AVX2
+static inline __m256i string_view__charset_classify_avx2(__m256i block, __m256i low_rows, __m256i high_rows){
+    const __m256i bit_lookup = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i high_nibbles = _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0f));
+    const __m256i low_indices = _mm256_and_si256(block, _mm256_set1_epi8((char)0x8f));
+    const __m256i high_indices = _mm256_xor_si256(low_indices, _mm256_set1_epi8((char)0x80));
+    const __m256i rows = _mm256_or_si256(_mm256_shuffle_epi8(low_rows, low_indices),
+                                         _mm256_shuffle_epi8(high_rows, high_indices));
+    const __m256i bits = _mm256_shuffle_epi8(bit_lookup, high_nibbles);
+
+    return _mm256_cmpeq_epi8(_mm256_and_si256(rows, bits), bits);
+}
+
+STRING_VIEW__TARGET_AVX2
+static uint64_t string_view__charset_mask64_avx2(const char* p, const string_view_charset_t* set){
+    const __m256i low_rows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->low_rows));
+    const __m256i high_rows = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)set->high_rows));
+    const __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    const __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+
+    return (uint64_t)(uint32_t)_mm256_movemask_epi8(string_view__charset_classify_avx2(lo, low_rows, high_rows))
+        | ((uint64_t)(uint32_t)_mm256_movemask_epi8(string_view__charset_classify_avx2(hi, low_rows, high_rows)) << 32);
+}
+
+STRING_VIEW__TARGET_AVX512
+static uint64_t string_view__charset_mask64_avx512(const char* p, const string_view_charset_t* set){
+    const __m512i low_rows = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)set->low_rows));
+    const __m512i high_rows = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)set->high_rows));
+    const __m512i bit_lookup = _mm512_broadcast_i32x4(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                                                    1, 2, 4, 8, 16, 32, 64, -128));
+    const __m512i block = _mm512_loadu_si512((const void*)p);
+    const __m512i high_nibbles = _mm512_and_si512(_mm512_srli_epi16(block, 4), _mm512_set1_epi8(0x0f));
+    const __m512i low_indices = _mm512_and_si512(block, _mm512_set1_epi8((char)0x8f));
+    const __m512i high_indices = _mm512_xor_si512(low_indices, _mm512_set1_epi8((char)0x80));
+    const __m512i rows = _mm512_or_si512(_mm512_shuffle_epi8(low_rows, low_indices),
+                                         _mm512_shuffle_epi8(high_rows, high_indices));
+    const __m512i bits = _mm512_shuffle_epi8(bit_lookup, high_nibbles);
+
+    return _mm512_cmpeq_epi8_mask(_mm512_and_si512(rows, bits), bits);
+}
+
+#endif
+
+/* SSE2 handles the sets that list their bytes; larger sets use the bitmap at that level. */
+static inline uint64_t string_view__charset_mask64(int level, const char* p, const string_view_charset_t* set){
+    switch(level){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__charset_mask64_avx512(p, set);
+    case STRING_VIEW_SIMD_AVX2: return string_view__charset_mask64_avx2(p, set);
+    case STRING_VIEW_SIMD_SSE2:
+        if(set->char_count != 0) return string_view__charset_mask64_sse2(p, set);
+        return string_view__charset_mask64_scalar(p, set);
+#endif
+    default: return string_view__charset_mask64_scalar(p, set);
+    }
+}
+
+/* Whether the 64-byte kernels beat a byte-by-byte bitmap scan for this set. */
+static inline bool string_view__charset_vectorized(int level, const string_view_charset_t* set){
+    return level >= STRING_VIEW_SIMD_AVX2 || (level == STRING_VIEW_SIMD_SSE2 && set->char_count != 0);
+}
+
+/* Returns the index of the first byte of `p[0..n)` whose membership equals `member`. */
+static size_t string_view__charset_find(const char* p, size_t n, const string_view_charset_t* set, bool member){
+    const int level = string_view__simd();
+    const uint64_t flip = member ? 0 : ~0ULL;
+    size_t i = 0;
+
+    if(string_view__charset_vectorized(level, set)){
+        for(; i + 64 <= n; i += 64){
+            const uint64_t mask = string_view__charset_mask64(level, &p[i], set) ^ flip;
+            if(mask != 0) return i + (size_t)string_view__ctz64(mask);
+        }
+    }
+
+    for(; i < n; i++){
+        if(string_view_charset_contains(set, p[i]) == member) return i;
+    }
+    return STRING_VIEW_NPOS;
+}
+
+/* Returns the index of the last byte of `p[0..n)` whose membership equals `member`. */
+static size_t string_view__charset_rfind(const char* p, size_t n, const string_view_charset_t* set, bool member){
+    const int level = string_view__simd();
+    const uint64_t flip = member ? 0 : ~0ULL;
+    size_t i = n;
+
+    if(string_view__charset_vectorized(level, set)){
+        for(; i >= 64; i -= 64){
+            const uint64_t mask = string_view__charset_mask64(level, &p[i - 64], set) ^ flip;
+            if(mask != 0) return i - 1 - (size_t)string_view__clz64(mask);
+        }
+    }
+
+    while(i-- > 0){
+        if(string_view_charset_contains(set, p[i]) == member) return i;
+    }
+    return STRING_VIEW_NPOS;
+}
+
+size_t string_view_find_first_of(string_view_t sv, const string_view_charset_t* set, size_t start){
+    if(start >= sv.count) return STRING_VIEW_NPOS;
+
+    const size_t pos = string_view__charset_find(sv.data + start, sv.count - start, set, true);
+    return (pos == STRING_VIEW_NPOS) ? pos : start + pos;
+}
+
+size_t string_view_find_first_not_of(string_view_t sv, const string_view_charset_t* set, size_t start){
+    if(start >= sv.count) return STRING_VIEW_NPOS;
+
+    const size_t pos = string_view__charset_find(sv.data + start, sv.count - start, set, false);
+    return (pos == STRING_VIEW_NPOS) ? pos : start + pos;
+}
+
+size_t string_view_find_last_of(string_view_t sv, const string_view_charset_t* set, size_t start){
+    if(sv.count == 0) return STRING_VIEW_NPOS;
+    return string_view__charset_rfind(sv.data, (start < sv.count) ? start + 1 : sv.count, set, true);
+}
+
+size_t string_view_find_last_not_of(string_view_t sv, const string_view_charset_t* set, size_t start){
+    if(sv.count == 0) return STRING_VIEW_NPOS;
+    return string_view__charset_rfind(sv.data, (start < sv.count) ? start + 1 : sv.count, set, false);
+}
+
+void string_view_trim_chars(string_view_t* sv, const string_view_charset_t* set){
+    const size_t first = string_view_find_first_not_of(*sv, set, 0);
+
+    if(first == STRING_VIEW_NPOS){
+        sv->data += sv->count;
+        sv->count = 0;
+        return;
+    }
+
+    const size_t last = string_view_find_last_not_of(*sv, set, STRING_VIEW_NPOS);
+    sv->data += first;
+    sv->count = last + 1 - first;
+}
+
+inline string_view_split_iter_t new_string_view_split_iter_char(string_view_t sv, char delimiter){
+    return (string_view_split_iter_t) {
+        .rest = sv,
+        .delimiter = STRING_VIEW_EMPTY,
+        .character = delimiter,
+        .mode = STRING_VIEW_SPLIT_CHAR,
+        .done = false,
+        .set = {{0}, {0}, {0}}
+    };
+}
+
+string_view_split_iter_t new_string_view_split_iter_any(string_view_t sv, string_view_t delimiters){
+    string_view_split_iter_t iter = {
+        .rest = sv,
+        .delimiter = delimiters,
+        .character = '\0',
+        .mode = STRING_VIEW_SPLIT_ANY,
+        .done = false,
+        .set = new_string_view_charset(delimiters)
+    };
+
+    return iter;
+}
+
+inline string_view_split_iter_t new_string_view_split_iter_substring(string_view_t sv, string_view_t delimiter){
+    return (string_view_split_iter_t) {
+        .rest = sv,
+        .delimiter = delimiter,
+        .character = '\0',
+        .mode = STRING_VIEW_SPLIT_SUBSTRING,
+        .done = false,
+        .set = {{0}, {0}, {0}}
+    };
+}
+
+bool string_view_split_next(string_view_split_iter_t* iter, string_view_t* token){
+    size_t pos = STRING_VIEW_NPOS;
+    size_t skip = 1;
+
+    if(iter->done) return false;
+
+    switch(iter->mode){
+    case STRING_VIEW_SPLIT_CHAR:
+        pos = string_view__find_char(iter->rest.data, iter->rest.count, iter->character);
+        break;
+    case STRING_VIEW_SPLIT_ANY:
+        pos = string_view__charset_find(iter->rest.data, iter->rest.count, &iter->set, true);
+        break;
+    case STRING_VIEW_SPLIT_SUBSTRING:
+        skip = iter->delimiter.count;
+        if(skip > 0) pos = string_view_find_substring(iter->rest, iter->delimiter, 0);
+        break;
+    }
+
+    if(pos == STRING_VIEW_NPOS){
+        *token = iter->rest;
+        iter->rest.count = 0;
+        iter->done = true;
+        return true;
+    }
+
+    *token = new_string_view(iter->rest.data, pos);
+    iter->rest.data += pos + skip;
+    iter->rest.count -= pos + skip;
+    return true;
+}
+
+size_t string_view_split_into(string_view_t sv, string_view_t delimiters, string_view_t* tokens, size_t capacity){
+    const int level = string_view__simd();
+    const string_view_charset_t set = new_string_view_charset(delimiters);
+    const char* data = sv.data;
+    const size_t n = sv.count;
+    size_t count = 0, token_start = 0, base = 0;
+    char tail[64];
+
+    while(base < n){
+        const char* block = &data[base];
+        uint64_t valid = ~0ULL;
+
+        if(n - base < 64){
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, block, n - base);
+            block = tail;
+            valid = (1ULL << (n - base)) - 1;
+        }
+
+        uint64_t mask = valid & string_view__charset_mask64(level, block, &set);
+
+        while(mask != 0){
+            const size_t pos = base + (size_t)string_view__ctz64(mask);
+            if(count < capacity) tokens[count] = new_string_view(&data[token_start], pos - token_start);
+            count++;
+            token_start = pos + 1;
+            mask &= mask - 1;
+        }
+
+        base += 64;
+    }
+
+    if(count < capacity) tokens[count] = new_string_view(&data[token_start], n - token_start);
+    return count + 1;
+}
+
+inline string_view_line_iter_t new_string_view_line_iter(string_view_t sv){
+    return (string_view_line_iter_t) {
+        .rest = sv
+    };
+}
+
+bool string_view_line_next(string_view_line_iter_t* iter, string_view_t* line){
+
+    if(iter->rest.count == 0) return false;
+
+    const size_t pos = string_view__find_char(iter->rest.data, iter->rest.count, '\n');
+    if(pos == STRING_VIEW_NPOS){
+        *line = iter->rest;
+        iter->rest.data += iter->rest.count;
+        iter->rest.count = 0;
+    }else{
+        *line = new_string_view(iter->rest.data, pos);
+        iter->rest.data += pos + 1;
+        iter->rest.count -= pos + 1;
+        if(pos > 0 && line->data[pos - 1] == '\r') line->count--;
+    }
+
+    return true;
+}
+
+bool string_view_reader_init(string_view_reader_t* reader, size_t capacity, char delimiter,
+                             string_view_read_fn read, void* context){
+    memset(reader, 0, sizeof(*reader));
+    if(capacity == 0) capacity = 1;
+
+    reader->buffer = STRING_VIEW_MALLOC(capacity);
+    if(reader->buffer == NULL) return false;
+
+    reader->capacity = capacity;
+    reader->delimiter = delimiter;
+    reader->read = read;
+    reader->context = context;
+    return true;
+}
+
+void string_view_reader_free(string_view_reader_t* reader){
+    STRING_VIEW_FREE(reader->buffer);
+    reader->buffer = NULL;
+    reader->capacity = reader->begin = reader->end = reader->scanned = 0;
+}
+
+/* Makes room at the end of the buffer: drops the consumed bytes, moves the incomplete
+   record to the front and grows the buffer when the record alone fills it. */
+static bool string_view__reader_compact(string_view_reader_t* reader){
+    const size_t pending = reader->end - reader->begin;
+
+    if(reader->begin > 0){
+        if(pending > 0){
+            memmove(reader->buffer, &reader->buffer[reader->begin], pending);
+            reader->bytes_copied += pending;
+        }
+        reader->scanned -= reader->begin;
+        reader->begin = 0;
+        reader->end = pending;
+    }
+
+    if(reader->end == reader->capacity){
+        char* buffer = STRING_VIEW_REALLOC(reader->buffer, reader->capacity * 2);
+        if(buffer == NULL) return false;
+
+        if(buffer != reader->buffer) reader->bytes_copied += reader->end;
+        reader->buffer = buffer;
+        reader->capacity *= 2;
+    }
+
+    return true;
+}
+
+bool string_view_reader_next(string_view_reader_t* reader, string_view_t* record){
+
+    while(true){
+        const size_t pos = string_view__find_char(&reader->buffer[reader->scanned],
+                                                  reader->end - reader->scanned, reader->delimiter);
+        if(pos != STRING_VIEW_NPOS){
+            const size_t stop = reader->scanned + pos;
+            *record = new_string_view(&reader->buffer[reader->begin], stop - reader->begin);
+            reader->begin = reader->scanned = stop + 1;
+            reader->bytes_yielded += record->count;
+            reader->records++;
+            return true;
+        }
+        reader->scanned = reader->end;
+
+        if(reader->eof){
+            if(reader->begin == reader->end) return false;
+
+            *record = new_string_view(&reader->buffer[reader->begin], reader->end - reader->begin);
+            reader->begin = reader->scanned = reader->end;
+            reader->bytes_yielded += record->count;
+            reader->records++;
+            return true;
+        }
+
+        if(!string_view__reader_compact(reader)){
+            reader->error = reader->eof = true;
+            return false;
+        }
+
+        const ptrdiff_t count = reader->read(reader->context, &reader->buffer[reader->end],
+                                             reader->capacity - reader->end);
+        if(count < 0){
+            reader->error = reader->eof = true;
+            return false;
+        }
+
+        reader->eof = (count == 0);
+        reader->end += (size_t)count;
+    }
+}
+
+#ifdef STRING_VIEW_HAS_MMAP
+
+/* madvise is not exposed in strict ISO C modes, so fall back to posix_madvise or to no hint at all. */
+static bool string_view__advise(void* address, size_t size, string_view_advice_t advice){
+#if defined(MADV_NORMAL)
+    int hint = MADV_NORMAL;
+    switch(advice){
+    case STRING_VIEW_ADVICE_SEQUENTIAL: hint = MADV_SEQUENTIAL; break;
+    case STRING_VIEW_ADVICE_RANDOM: hint = MADV_RANDOM; break;
+    case STRING_VIEW_ADVICE_WILLNEED: hint = MADV_WILLNEED; break;
+    default: break;
+    }
+    return madvise(address, size, hint) == 0;
+#elif defined(POSIX_MADV_NORMAL)
+    int hint = POSIX_MADV_NORMAL;
+    switch(advice){
+    case STRING_VIEW_ADVICE_SEQUENTIAL: hint = POSIX_MADV_SEQUENTIAL; break;
+    case STRING_VIEW_ADVICE_RANDOM: hint = POSIX_MADV_RANDOM; break;
+    case STRING_VIEW_ADVICE_WILLNEED: hint = POSIX_MADV_WILLNEED; break;
+    default: break;
+    }
+    return posix_madvise(address, size, hint) == 0;
+#else
+    (void)address;
+    (void)size;
+    (void)advice;
+    return true;
+#endif
+}
+
+bool string_view_mmap_open(string_view_mmap_t* map, const char* path, string_view_advice_t advice){
+    struct stat info;
+
+    map->view = STRING_VIEW_EMPTY;
+    map->address = NULL;
+    map->size = 0;
+
+    const int fd = open(path, O_RDONLY);
+    if(fd < 0) return false;
+
+    if(fstat(fd, &info) != 0 || (uintmax_t)info.st_size > (uintmax_t)SIZE_MAX){
+        close(fd);
+        return false;
+    }
+
+    if(info.st_size > 0){
+        void* address = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(address == MAP_FAILED){
+            close(fd);
+            return false;
+        }
+
+        map->address = address;
+        map->size = (size_t)info.st_size;
+        map->view = new_string_view((const char*)address, map->size);
+        string_view__advise(address, map->size, advice);
+    }
+
+    close(fd);
+    return true;
+}
+
+bool string_view_mmap_advise(string_view_mmap_t* map, string_view_advice_t advice){
+    if(map->address == NULL) return true;
+    return string_view__advise(map->address, map->size, advice);
+}
+
+void string_view_mmap_close(string_view_mmap_t* map){
+    if(map->address != NULL) munmap(map->address, map->size);
+
+    map->view = STRING_VIEW_EMPTY;
+    map->address = NULL;
+    map->size = 0;
+}
+
+ptrdiff_t string_view_read_fd(void* context, char* buffer, size_t capacity){
+    ssize_t count;
+
+    do {
+        count = read(*(const int*)context, buffer, capacity);
+    } while(count < 0 && errno == EINTR);
+
+    return (ptrdiff_t)count;
+}
+
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STRING_VIEW__PREFETCH(ptr) __builtin_prefetch((ptr))
+#else
+#define STRING_VIEW__PREFETCH(ptr) ((void)(ptr))
+#endif
+
+static const uint64_t string_view__hash_secret[4] = {
+    0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+static inline void string_view__mum(uint64_t* a, uint64_t* b){
+#ifdef __SIZEOF_INT128__
+    const __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t lo = t + (rm1 << 32);
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t string_view__mix(uint64_t a, uint64_t b){
+    string_view__mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t string_view__read64(const uint8_t* p){
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline uint64_t string_view__read32(const uint8_t* p){
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/* Loads the two words hashed for a view of at most 16 bytes. The overlapping reads
+   cover every byte without a loop. */
+static inline void string_view__hash_short_words(const uint8_t* p, size_t n, uint64_t* a, uint64_t* b){
+    if(n >= 4){
+        const size_t shift = (n >> 3) << 2;
+        *a = (string_view__read32(p) << 32) | string_view__read32(p + shift);
+        *b = (string_view__read32(p + n - 4) << 32) | string_view__read32(p + n - 4 - shift);
+    }else if(n > 0){
+        *a = ((uint64_t)p[0] << 16) | ((uint64_t)p[n >> 1] << 8) | p[n - 1];
+        *b = 0;
+    }else{
+        *a = *b = 0;
+    }
+}
+
+static inline uint64_t string_view__hash_seed(uint64_t seed){
+    return seed ^ string_view__mix(seed ^ string_view__hash_secret[0], string_view__hash_secret[1]);
+}
+
+static inline uint64_t string_view__hash_finish(uint64_t a, uint64_t b, uint64_t seed, size_t n){
+    a ^= string_view__hash_secret[1];
+    b ^= seed;
+    string_view__mum(&a, &b);
+    return string_view__mix(a ^ string_view__hash_secret[0] ^ n, b ^ string_view__hash_secret[1]);
+}
+
+static uint64_t string_view__hash_long(const uint8_t* p, size_t n, uint64_t seed){
+    const uint64_t* secret = string_view__hash_secret;
+    size_t i = n;
+
+    if(i >= 48){
+        uint64_t seed1 = seed, seed2 = seed;
+        do {
+            seed = string_view__mix(string_view__read64(p) ^ secret[1], string_view__read64(p + 8) ^ seed);
+            seed1 = string_view__mix(string_view__read64(p + 16) ^ secret[2], string_view__read64(p + 24) ^ seed1);
+            seed2 = string_view__mix(string_view__read64(p + 32) ^ secret[3], string_view__read64(p + 40) ^ seed2);
+            p += 48;
+            i -= 48;
+        } while(i >= 48);
+        seed ^= seed1 ^ seed2;
+    }
+
+    while(i > 16){
+        seed = string_view__mix(string_view__read64(p) ^ secret[1], string_view__read64(p + 8) ^ seed);
+        p += 16;
+        i -= 16;
+    }
+
+    return string_view__hash_finish(string_view__read64(p + i - 16), string_view__read64(p + i - 8), seed, n);
+}
+
+uint64_t string_view_hash(string_view_t sv, uint64_t seed){
+    const uint8_t* p = (const uint8_t*)sv.data;
+    uint64_t a, b;
+
+    seed = string_view__hash_seed(seed);
+    if(sv.count > 16) return string_view__hash_long(p, sv.count, seed);
+
+    string_view__hash_short_words(p, sv.count, &a, &b);
+    return string_view__hash_finish(a, b, seed, sv.count);
+}
+
+#define STRING_VIEW__HASH_PREFETCH_DISTANCE 8
+
+void string_view_hash_many(const string_view_t* views, size_t count, uint64_t seed, uint64_t* hashes){
+    const uint64_t mixed_seed = string_view__hash_seed(seed);
+    size_t i = 0;
+
+    for(; i + 4 <= count; i += 4){
+        for(size_t j = i + STRING_VIEW__HASH_PREFETCH_DISTANCE; j < i + STRING_VIEW__HASH_PREFETCH_DISTANCE + 4 && j < count; j++){
+            STRING_VIEW__PREFETCH(views[j].data);
+        }
+
+        const string_view_t* group = &views[i];
+        if(group[0].count <= 16 && group[1].count <= 16 && group[2].count <= 16 && group[3].count <= 16){
+            uint64_t a[4], b[4];
+            for(size_t k = 0; k < 4; k++){
+                string_view__hash_short_words((const uint8_t*)group[k].data, group[k].count, &a[k], &b[k]);
+            }
+            for(size_t k = 0; k < 4; k++){
+                hashes[i + k] = string_view__hash_finish(a[k], b[k], mixed_seed, group[k].count);
+            }
+        }else{
+            for(size_t k = 0; k < 4; k++){
+                hashes[i + k] = string_view_hash(group[k], seed);
+            }
+        }
+    }
+
+    for(; i < count; i++){
+        hashes[i] = string_view_hash(views[i], seed);
+    }
+}
+
+#define STRING_VIEW__PREFIXED_INLINE 12
+
+string_view_prefixed_t new_string_view_prefixed(string_view_t sv){
+    string_view_prefixed_t result;
+
+    memset(&result, 0, sizeof(result));
+    result.count = (uint32_t)sv.count;
+
+    if(sv.count <= STRING_VIEW__PREFIXED_INLINE){
+        /* The prefix and the inline bytes are contiguous. */
+        if(sv.count > 0) memcpy((char*)&result + offsetof(string_view_prefixed_t, prefix), sv.data, sv.count);
+    }else{
+        memcpy(result.prefix, sv.data, sizeof(result.prefix));
+        result.payload.data = sv.data;
+    }
+
+    return result;
+}
+
+string_view_t string_view_prefixed_to_view(const string_view_prefixed_t* sv){
+    if(sv->count <= STRING_VIEW__PREFIXED_INLINE){
+        return new_string_view((const char*)sv + offsetof(string_view_prefixed_t, prefix), sv->count);
+    }
+    return new_string_view(sv->payload.data, sv->count);
+}
+
+bool string_view_prefixed_equal(const string_view_prefixed_t* sv1, const string_view_prefixed_t* sv2){
+    uint64_t head1, head2;
+
+    /* Length and prefix in one compare. */
+    memcpy(&head1, sv1, sizeof(head1));
+    memcpy(&head2, sv2, sizeof(head2));
+    if(head1 != head2) return false;
+
+    if(sv1->count <= STRING_VIEW__PREFIXED_INLINE){
+        return memcmp(sv1->payload.inline_data, sv2->payload.inline_data, sizeof(sv1->payload.inline_data)) == 0;
+    }
+
+    return sv1->payload.data == sv2->payload.data
+        || memcmp(sv1->payload.data + 4, sv2->payload.data + 4, sv1->count - 4) == 0;
+}
+
+int string_view_prefixed_compare(const string_view_prefixed_t* sv1, const string_view_prefixed_t* sv2){
+    const uint32_t count = (sv1->count < sv2->count) ? sv1->count : sv2->count;
+    const int order = memcmp(sv1->prefix, sv2->prefix, (count < 4) ? count : 4);
+
+    if(order != 0) return order;
+
+    if(count > 4){
+        const char* data1 = (sv1->count <= STRING_VIEW__PREFIXED_INLINE) ? sv1->payload.inline_data : sv1->payload.data + 4;
+        const char* data2 = (sv2->count <= STRING_VIEW__PREFIXED_INLINE) ? sv2->payload.inline_data : sv2->payload.data + 4;
+        const int rest = memcmp(data1, data2, count - 4);
+        if(rest != 0) return rest;
+    }
+
+    return (sv1->count > sv2->count) - (sv1->count < sv2->count);
+}
+
+uint64_t string_view_prefixed_hash(const string_view_prefixed_t* sv, uint64_t seed){
+    return string_view_hash(string_view_prefixed_to_view(sv), seed);
+}
+
+#define STRING_VIEW__MAP_GROUP 16
+#define STRING_VIEW__MAP_EMPTY 0x80
+#define STRING_VIEW__MAP_DELETED 0xFE
+#define STRING_VIEW__MAP_SEED 0x9e3779b97f4a7c15ULL
+#define STRING_VIEW__MAP_BATCH 32
+
+static inline uint32_t string_view__group_match_scalar(const uint8_t* group, uint8_t byte){
+    uint32_t mask = 0;
+    for(uint32_t i = 0; i < STRING_VIEW__MAP_GROUP; i++){
+        mask |= (uint32_t)(group[i] == byte) << i;
+    }
+    return mask;
+}
+
+#ifdef STRING_VIEW__X86
+STRING_VIEW__TARGET_SSE2
+static inline uint32_t string_view__group_match_sse2(const uint8_t* group, uint8_t byte){
+    const __m128i control = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)byte)));
+}
+#endif
+
+/* Returns the mask of the control bytes of a group equal to `byte`. */
+static inline uint32_t string_view__group_match(const uint8_t* group, uint8_t byte){
+#ifdef STRING_VIEW__X86
+    if(string_view__simd() >= STRING_VIEW_SIMD_SSE2) return string_view__group_match_sse2(group, byte);
+#endif
+    return string_view__group_match_scalar(group, byte);
+}
+
+static inline uint64_t string_view__key_prefix(string_view_t key){
+    uint64_t prefix = 0;
+    if(key.count > 0) memcpy(&prefix, key.data, key.count < 8 ? key.count : 8);
+    return prefix;
+}
+
+static inline bool string_view__slot_equal(const string_view_map_slot_t* slot, string_view_t key, uint64_t prefix){
+    return slot->count == key.count && slot->prefix == prefix
+        && (key.count <= 8 || memcmp(slot->data + 8, key.data + 8, key.count - 8) == 0);
+}
+
+static inline size_t string_view__map_group(const string_view_map_t* map, uint64_t hash){
+    return (size_t)(hash >> 7) & (map->capacity / STRING_VIEW__MAP_GROUP - 1);
+}
+
+/* Returns the index of the slot holding `key`, or STRING_VIEW_NPOS. */
+static size_t string_view__map_find(const string_view_map_t* map, string_view_t key, uint64_t hash){
+    const size_t group_mask = map->capacity / STRING_VIEW__MAP_GROUP - 1;
+    const uint8_t tag = (uint8_t)(hash & 0x7F);
+    const uint64_t prefix = string_view__key_prefix(key);
+    size_t group = string_view__map_group(map, hash);
+
+    for(size_t step = 1; step <= group_mask + 1; step++){
+        const uint8_t* control = &map->control[group * STRING_VIEW__MAP_GROUP];
+        uint32_t mask = string_view__group_match(control, tag);
+
+        while(mask != 0){
+            const size_t index = group * STRING_VIEW__MAP_GROUP + (size_t)string_view__ctz32(mask);
+            if(string_view__slot_equal(&map->slots[index], key, prefix)) return index;
+            mask &= mask - 1;
+        }
+
+        if(string_view__group_match(control, STRING_VIEW__MAP_EMPTY) != 0) break;
+        group = (group + step) & group_mask;
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+/* Stores a key that is known not to be in the map. The map must have a free slot. */
+static void string_view__map_place(string_view_map_t* map, string_view_t key, uint64_t hash, uint64_t value){
+    const size_t group_mask = map->capacity / STRING_VIEW__MAP_GROUP - 1;
+    size_t group = string_view__map_group(map, hash);
+
+    for(size_t step = 1; ; step++){
+        uint8_t* control = &map->control[group * STRING_VIEW__MAP_GROUP];
+        const uint32_t mask = string_view__group_match(control, STRING_VIEW__MAP_EMPTY)
+            | string_view__group_match(control, STRING_VIEW__MAP_DELETED);
+
+        if(mask != 0){
+            const size_t index = group * STRING_VIEW__MAP_GROUP + (size_t)string_view__ctz32(mask);
+            if(map->control[index] == STRING_VIEW__MAP_DELETED) map->tombstones--;
+
+            map->control[index] = (uint8_t)(hash & 0x7F);
+            map->slots[index] = (string_view_map_slot_t) {
+                .data = key.data,
+                .count = key.count,
+                .prefix = string_view__key_prefix(key),
+                .value = value
+            };
+            map->size++;
+            return;
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+static bool string_view__map_rehash(string_view_map_t* map, size_t capacity){
+    string_view_map_t resized = *map;
+
+    if(capacity > SIZE_MAX / sizeof(string_view_map_slot_t)) return false;
+
+    resized.control = STRING_VIEW_MALLOC(capacity);
+    resized.slots = STRING_VIEW_MALLOC(capacity * sizeof(string_view_map_slot_t));
+    if(resized.control == NULL || resized.slots == NULL){
+        STRING_VIEW_FREE(resized.control);
+        STRING_VIEW_FREE(resized.slots);
+        return false;
+    }
+
+    memset(resized.control, STRING_VIEW__MAP_EMPTY, capacity);
+    resized.capacity = capacity;
+    resized.size = 0;
+    resized.tombstones = 0;
+
+    for(size_t i = 0; i < map->capacity; i++){
+        if(map->control[i] & 0x80) continue;
+
+        const string_view_t key = new_string_view(map->slots[i].data, map->slots[i].count);
+        string_view__map_place(&resized, key, string_view_hash(key, map->seed), map->slots[i].value);
+    }
+
+    STRING_VIEW_FREE(map->control);
+    STRING_VIEW_FREE(map->slots);
+    *map = resized;
+    return true;
+}
+
+static size_t string_view__map_capacity_for(size_t count){
+    size_t capacity = STRING_VIEW__MAP_GROUP;
+    while(capacity - capacity / 8 < count){
+        /* Too large to allocate; the rehash rejects it. */
+        if(capacity > SIZE_MAX / 2) return SIZE_MAX;
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+bool string_view_map_init(string_view_map_t* map, size_t capacity){
+    map->control = NULL;
+    map->slots = NULL;
+    map->capacity = 0;
+    map->size = 0;
+    map->tombstones = 0;
+    map->seed = STRING_VIEW__MAP_SEED;
+
+    return string_view__map_rehash(map, string_view__map_capacity_for(capacity));
+}
+
+void string_view_map_free(string_view_map_t* map){
+    STRING_VIEW_FREE(map->control);
+    STRING_VIEW_FREE(map->slots);
+    map->control = NULL;
+    map->slots = NULL;
+    map->capacity = map->size = map->tombstones = 0;
+}
+
+bool string_view_map_reserve(string_view_map_t* map, size_t count){
+    if(count < map->size) count = map->size;
+    if(count + map->tombstones <= map->capacity - map->capacity / 8) return true;
+    return string_view__map_rehash(map, string_view__map_capacity_for(count));
+}
+
+static bool string_view__map_insert_hashed(string_view_map_t* map, string_view_t key, uint64_t hash, uint64_t value){
+    const size_t index = string_view__map_find(map, key, hash);
+
+    if(index != STRING_VIEW_NPOS){
+        map->slots[index].value = value;
+        return true;
+    }
+
+    if(map->size + map->tombstones + 1 > map->capacity - map->capacity / 8){
+        /* Mostly tombstones: clean them up in place, otherwise double the table. */
+        const size_t target = (map->tombstones > map->size / 2) ? map->size + 1 : (map->size + 1) * 2;
+        if(!string_view__map_rehash(map, string_view__map_capacity_for(target))) return false;
+    }
+
+    string_view__map_place(map, key, hash, value);
+    return true;
+}
+
+bool string_view_map_insert(string_view_map_t* map, string_view_t key, uint64_t value){
+    return string_view__map_insert_hashed(map, key, string_view_hash(key, map->seed), value);
+}
+
+bool string_view_map_lookup(const string_view_map_t* map, string_view_t key, uint64_t* value){
+    const size_t index = string_view__map_find(map, key, string_view_hash(key, map->seed));
+
+    if(index == STRING_VIEW_NPOS) return false;
+    if(value != NULL) *value = map->slots[index].value;
+    return true;
+}
+
+bool string_view_map_remove(string_view_map_t* map, string_view_t key){
+    const size_t index = string_view__map_find(map, key, string_view_hash(key, map->seed));
+
+    if(index == STRING_VIEW_NPOS) return false;
+
+    /* A group that still has an empty slot always ended the probe sequences that reached it,
+       so the slot can become empty again instead of a tombstone. */
+    const uint8_t* group = &map->control[index - index % STRING_VIEW__MAP_GROUP];
+    if(string_view__group_match(group, STRING_VIEW__MAP_EMPTY) != 0){
+        map->control[index] = STRING_VIEW__MAP_EMPTY;
+    }else{
+        map->control[index] = STRING_VIEW__MAP_DELETED;
+        map->tombstones++;
+    }
+
+    map->size--;
+    return true;
+}
+
+static void string_view__map_prefetch(const string_view_map_t* map, const uint64_t* hashes, size_t count){
+    for(size_t i = 0; i < count; i++){
+        const size_t group = string_view__map_group(map, hashes[i]) * STRING_VIEW__MAP_GROUP;
+        STRING_VIEW__PREFETCH(&map->control[group]);
+        STRING_VIEW__PREFETCH(&map->slots[group]);
+    }
+}
+
+size_t string_view_map_lookup_batch(const string_view_map_t* map, const string_view_t* keys, size_t count,
+                                    uint64_t* values, bool* found){
+    uint64_t hashes[STRING_VIEW__MAP_BATCH];
+    size_t total = 0;
+
+    for(size_t base = 0; base < count; base += STRING_VIEW__MAP_BATCH){
+        const size_t batch = (count - base < STRING_VIEW__MAP_BATCH) ? count - base : STRING_VIEW__MAP_BATCH;
+
+        string_view_hash_many(&keys[base], batch, map->seed, hashes);
+        string_view__map_prefetch(map, hashes, batch);
+
+        for(size_t i = 0; i < batch; i++){
+            const size_t index = string_view__map_find(map, keys[base + i], hashes[i]);
+            if(index != STRING_VIEW_NPOS){
+                values[base + i] = map->slots[index].value;
+                total++;
+            }
+            if(found != NULL) found[base + i] = (index != STRING_VIEW_NPOS);
+        }
+    }
+
+    return total;
+}
+
+bool string_view_map_insert_batch(string_view_map_t* map, const string_view_t* keys, const uint64_t* values, size_t count){
+    uint64_t hashes[STRING_VIEW__MAP_BATCH];
+
+    if(!string_view_map_reserve(map, map->size + count)) return false;
+
+    for(size_t base = 0; base < count; base += STRING_VIEW__MAP_BATCH){
+        const size_t batch = (count - base < STRING_VIEW__MAP_BATCH) ? count - base : STRING_VIEW__MAP_BATCH;
+
+        string_view_hash_many(&keys[base], batch, map->seed, hashes);
+        string_view__map_prefetch(map, hashes, batch);
+
+        for(size_t i = 0; i < batch; i++){
+            if(!string_view__map_insert_hashed(map, keys[base + i], hashes[i], values[base + i])) return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef STRING_VIEW_HAS_ATOMICS
+#define STRING_VIEW__INTERN_BLOCK 65536
+#define STRING_VIEW__INTERN_SEED 0x2d358dccaa6c78a5ULL
+
+struct string_view__intern_record {
+    uint64_t hash;
+    size_t count;
+    char data[];
+};
+
+struct string_view__intern_block {
+    struct string_view__intern_block* next;
+    size_t capacity;
+    size_t used;
+    char data[];
+};
+
+/*
+ * Lock-free bump allocation: the current block is the head of the block list. When it is exhausted,
+ * every racing thread allocates a fresh block and tries to push it; the losers free theirs and retry
+ * on the winner's block.
+ */
+static void* string_view__intern_alloc(string_view_intern_pool_t* pool, size_t size){
+    size = (size + 7) & ~(size_t)7;
+
+    for(;;){
+        struct string_view__intern_block* block = STRING_VIEW__LOAD_ACQUIRE(&pool->blocks);
+
+        if(block != NULL && STRING_VIEW__LOAD_RELAXED(&block->used) + size <= block->capacity){
+            const size_t offset = STRING_VIEW__FETCH_ADD(&block->used, size);
+            if(offset + size <= block->capacity) return block->data + offset;
+        }
+
+        const size_t capacity = (size > STRING_VIEW__INTERN_BLOCK) ? size : STRING_VIEW__INTERN_BLOCK;
+        struct string_view__intern_block* fresh = STRING_VIEW_MALLOC(sizeof(*fresh) + capacity);
+        if(fresh == NULL) return NULL;
+
+        fresh->next = block;
+        fresh->capacity = capacity;
+        fresh->used = size;
+        if(STRING_VIEW__CAS(&pool->blocks, &block, fresh)) return fresh->data;
+        STRING_VIEW_FREE(fresh);
+    }
+}
+
+/* Gives back the most recent allocation of the current block; anything allocated after it keeps it in place. */
+static void string_view__intern_unalloc(string_view_intern_pool_t* pool, void* memory, size_t size){
+    struct string_view__intern_block* block = STRING_VIEW__LOAD_ACQUIRE(&pool->blocks);
+    size = (size + 7) & ~(size_t)7;
+
+    if(block == NULL) return;
+
+    size_t used = STRING_VIEW__LOAD_RELAXED(&block->used);
+    if(used <= block->capacity && used >= size && block->data + used - size == (char*)memory){
+        STRING_VIEW__CAS(&block->used, &used, used - size);
+    }
+}
+
+static inline bool string_view__intern_matches(const struct string_view__intern_record* record,
+                                               string_view_t sv, uint64_t hash){
+    return record->hash == hash && record->count == sv.count
+        && (sv.count == 0 || memcmp(record->data, sv.data, sv.count) == 0);
+}
+
+bool string_view_intern_pool_init(string_view_intern_pool_t* pool, size_t capacity){
+    size_t slots = 16;
+
+    /* Keep the table at most half full so probe sequences stay short. */
+    while(slots / 2 < capacity){
+        if(slots > SIZE_MAX / 4 / sizeof(*pool->slots)) return false;
+        slots *= 2;
+    }
+
+    pool->slots = STRING_VIEW_CALLOC(slots, sizeof(*pool->slots));
+    pool->blocks = NULL;
+    pool->slot_count = slots;
+    pool->capacity = capacity;
+    pool->size = 0;
+    pool->reserved = 0;
+    pool->seed = STRING_VIEW__INTERN_SEED;
+    return pool->slots != NULL;
+}
+
+void string_view_intern_pool_free(string_view_intern_pool_t* pool){
+    struct string_view__intern_block* block = pool->blocks;
+
+    while(block != NULL){
+        struct string_view__intern_block* next = block->next;
+        STRING_VIEW_FREE(block);
+        block = next;
+    }
+
+    STRING_VIEW_FREE(pool->slots);
+    pool->slots = NULL;
+    pool->blocks = NULL;
+    pool->slot_count = pool->capacity = pool->size = pool->reserved = 0;
+}
+
+size_t string_view_intern(string_view_intern_pool_t* pool, string_view_t sv, string_view_t* canonical){
+    const uint64_t hash = string_view_hash(sv, pool->seed);
+    const size_t mask = pool->slot_count - 1;
+    const size_t record_size = sizeof(struct string_view__intern_record) + sv.count + 1;
+    struct string_view__intern_record* fresh = NULL;
+    size_t index = (size_t)hash & mask;
+
+    for(size_t probe = 0; probe < pool->slot_count; probe++, index = (index + 1) & mask){
+        struct string_view__intern_record* record = STRING_VIEW__LOAD_ACQUIRE(&pool->slots[index]);
+
+        if(record == NULL){
+            /*
+             * A slot is claimed only with one of the `capacity` places reserved, which keeps the table at
+             * most half full. When every place is reserved but not all are used, the holders may still be
+             * inserting this very string, so the slot is watched until they are done.
+             */
+            size_t reserved = STRING_VIEW__LOAD_RELAXED(&pool->reserved);
+            for(;;){
+                if(reserved < pool->capacity){
+                    if(STRING_VIEW__CAS(&pool->reserved, &reserved, reserved + 1)) break;
+                    continue;
+                }
+
+                /* `size` grows after the slot is published, so a full pool can still have filled this slot. */
+                const bool full = STRING_VIEW__LOAD_ACQUIRE(&pool->size) >= pool->capacity;
+                record = STRING_VIEW__LOAD_ACQUIRE(&pool->slots[index]);
+                if(record != NULL) break;
+                if(full){
+                    if(fresh != NULL) string_view__intern_unalloc(pool, fresh, record_size);
+                    return STRING_VIEW_NPOS;
+                }
+                reserved = STRING_VIEW__LOAD_RELAXED(&pool->reserved);
+            }
+        }
+
+        if(record == NULL){
+            /* The copy is made once and reused if another thread takes the slot first. */
+            if(fresh == NULL){
+                fresh = string_view__intern_alloc(pool, record_size);
+                if(fresh == NULL){
+                    STRING_VIEW__FETCH_SUB(&pool->reserved, 1);
+                    return STRING_VIEW_NPOS;
+                }
+
+                fresh->hash = hash;
+                fresh->count = sv.count;
+                if(sv.count > 0) memcpy(fresh->data, sv.data, sv.count);
+                fresh->data[sv.count] = '\0';
+            }
+
+            if(STRING_VIEW__CAS(&pool->slots[index], &record, fresh)){
+                STRING_VIEW__FETCH_ADD(&pool->size, 1);
+                record = fresh;
+                fresh = NULL;
+            }else{
+                STRING_VIEW__FETCH_SUB(&pool->reserved, 1);
+            }
+        }
+
+        if(string_view__intern_matches(record, sv, hash)){
+            if(fresh != NULL) string_view__intern_unalloc(pool, fresh, record_size);
+            if(canonical != NULL) *canonical = new_string_view(record->data, record->count);
+            return index;
+        }
+    }
+
+    if(fresh != NULL) string_view__intern_unalloc(pool, fresh, record_size);
+    return STRING_VIEW_NPOS;
+}
+
+size_t string_view_intern_find(const string_view_intern_pool_t* pool, string_view_t sv, string_view_t* canonical){
+    const uint64_t hash = string_view_hash(sv, pool->seed);
+    const size_t mask = pool->slot_count - 1;
+    size_t index = (size_t)hash & mask;
+
+    for(size_t probe = 0; probe < pool->slot_count; probe++, index = (index + 1) & mask){
+        const struct string_view__intern_record* record = STRING_VIEW__LOAD_ACQUIRE(&pool->slots[index]);
+
+        if(record == NULL) break;
+        if(string_view__intern_matches(record, sv, hash)){
+            if(canonical != NULL) *canonical = new_string_view(record->data, record->count);
+            return index;
+        }
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+string_view_t string_view_intern_get(const string_view_intern_pool_t* pool, size_t id){
+    if(id >= pool->slot_count) return STRING_VIEW_EMPTY;
+
+    const struct string_view__intern_record* record = STRING_VIEW__LOAD_ACQUIRE(&pool->slots[id]);
+    return (record != NULL) ? new_string_view(record->data, record->count) : STRING_VIEW_EMPTY;
+}
+
+size_t string_view_intern_count(const string_view_intern_pool_t* pool){
+    return STRING_VIEW__LOAD_RELAXED(&pool->size);
+}
+#endif
+
+#define STRING_VIEW__ARENA_BLOCK 65536
+#define STRING_VIEW__ARENA_ALIGN 16
+
+struct string_view__arena_block {
+    struct string_view__arena_block* next;
+    size_t capacity;
+    char* data;
+};
+
+static void string_view__arena_enter(string_view_arena_t* arena, struct string_view__arena_block* block){
+    arena->current = block;
+    arena->cursor = block->data;
+    arena->end = block->data + block->capacity;
+}
+
+/* Moves to the next block able to hold `size` bytes, reusing blocks kept by a rewind when possible. */
+static bool string_view__arena_grow(string_view_arena_t* arena, size_t size){
+    struct string_view__arena_block* next = (arena->current != NULL) ? arena->current->next : arena->first;
+
+    if(next != NULL && next->capacity >= size){
+        string_view__arena_enter(arena, next);
+        return true;
+    }
+
+    const size_t capacity = (size > arena->block_size) ? size : arena->block_size;
+    if(capacity > SIZE_MAX - sizeof(struct string_view__arena_block) - STRING_VIEW__ARENA_ALIGN) return false;
+
+    struct string_view__arena_block* block =
+        STRING_VIEW_MALLOC(sizeof(*block) + capacity + STRING_VIEW__ARENA_ALIGN);
+    if(block == NULL) return false;
+
+    const uintptr_t data = (uintptr_t)(block + 1);
+    block->data = (char*)((data + STRING_VIEW__ARENA_ALIGN - 1) & ~(uintptr_t)(STRING_VIEW__ARENA_ALIGN - 1));
+    block->capacity = capacity;
+    block->next = next;
+
+    if(arena->current != NULL) arena->current->next = block;
+    else arena->first = block;
+
+    arena->blocks_allocated++;
+    string_view__arena_enter(arena, block);
+    return true;
+}
+
+static char* string_view__arena_bytes(string_view_arena_t* arena, size_t size, size_t align){
+    const uintptr_t cursor = (uintptr_t)arena->cursor;
+    size_t padding = (size_t)(-cursor & (uintptr_t)(align - 1));
+
+    if(arena->cursor == NULL || size + padding < size || size + padding > (size_t)(arena->end - arena->cursor)){
+        if(!string_view__arena_grow(arena, size)) return NULL;
+        padding = 0;
+    }
+
+    char* result = arena->cursor + padding;
+    arena->cursor = result + size;
+    arena->bytes_used += padding + size;
+    return result;
+}
+
+void string_view_arena_init(string_view_arena_t* arena, size_t block_size){
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->cursor = NULL;
+    arena->end = NULL;
+    arena->block_size = (block_size > 0) ? block_size : STRING_VIEW__ARENA_BLOCK;
+    arena->bytes_used = 0;
+    arena->blocks_allocated = 0;
+}
+
+void string_view_arena_free(string_view_arena_t* arena){
+    struct string_view__arena_block* block = arena->first;
+
+    while(block != NULL){
+        struct string_view__arena_block* next = block->next;
+        STRING_VIEW_FREE(block);
+        block = next;
+    }
+
+    string_view_arena_init(arena, arena->block_size);
+}
+
+void* string_view_arena_alloc(string_view_arena_t* arena, size_t size){
+    return string_view__arena_bytes(arena, size, STRING_VIEW__ARENA_ALIGN);
+}
+
+string_view_t string_view_arena_dup(string_view_arena_t* arena, string_view_t sv){
+    char* data = string_view__arena_bytes(arena, sv.count, 1);
+
+    if(data == NULL) return new_string_view(NULL, 0);
+    if(sv.count > 0) memcpy(data, sv.data, sv.count);
+    return new_string_view(data, sv.count);
+}
+
+char* string_view_arena_dup_cstr(string_view_arena_t* arena, string_view_t sv){
+    if(sv.count == SIZE_MAX) return NULL;
+
+    char* data = string_view__arena_bytes(arena, sv.count + 1, 1);
+
+    if(data == NULL) return NULL;
+    if(sv.count > 0) memcpy(data, sv.data, sv.count);
+    data[sv.count] = '\0';
+    return data;
+}
+
+string_view_t string_view_arena_concat(string_view_arena_t* arena, const string_view_t* views, size_t count){
+    size_t total = 1;
+
+    for(size_t i = 0; i < count; i++){
+        if(views[i].count > SIZE_MAX - total) return new_string_view(NULL, 0);
+        total += views[i].count;
+    }
+
+    char* data = string_view__arena_bytes(arena, total, 1);
+    if(data == NULL) return new_string_view(NULL, 0);
+
+    char* out = data;
+    for(size_t i = 0; i < count; i++){
+        if(views[i].count > 0) memcpy(out, views[i].data, views[i].count);
+        out += views[i].count;
+    }
+
+    *out = '\0';
+    return new_string_view(data, total - 1);
+}
+
+string_view_arena_mark_t string_view_arena_mark(const string_view_arena_t* arena){
+    string_view_arena_mark_t mark = { arena->current, arena->cursor, arena->bytes_used };
+    return mark;
+}
+
+void string_view_arena_rewind(string_view_arena_t* arena, string_view_arena_mark_t mark){
+    if(mark.block == NULL){
+        string_view_arena_reset(arena);
+        return;
+    }
+
+    arena->current = mark.block;
+    arena->cursor = mark.cursor;
+    arena->end = mark.block->data + mark.block->capacity;
+    arena->bytes_used = mark.bytes_used;
+}
+
+void string_view_arena_reset(string_view_arena_t* arena){
+    arena->bytes_used = 0;
+
+    if(arena->first == NULL) return;
+    string_view__arena_enter(arena, arena->first);
+}
+
+static const char string_view__digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+/* Writes the digits of `value` right-aligned before `end` and returns a pointer to the first one. */
+static char* string_view__format_u64(char* end, uint64_t value){
+    while(value >= 100){
+        const size_t pair = (size_t)(value % 100) * 2;
+        value /= 100;
+        *--end = string_view__digit_pairs[pair + 1];
+        *--end = string_view__digit_pairs[pair];
+    }
+
+    if(value >= 10){
+        *--end = string_view__digit_pairs[value * 2 + 1];
+        *--end = string_view__digit_pairs[value * 2];
+    }else{
+        *--end = (char)('0' + value);
+    }
+
+    return end;
+}
+
+string_builder_t new_string_builder(void){
+    string_builder_t builder = { NULL, 0, 0, true, false };
+    return builder;
+}
+
+string_builder_t new_string_builder_fixed(char* buffer, size_t capacity){
+    string_builder_t builder = { buffer, 0, capacity, false, false };
+    if(capacity > 0) buffer[0] = '\0';
+    return builder;
+}
+
+void string_builder_free(string_builder_t* builder){
+    if(builder->owned) STRING_VIEW_FREE(builder->data);
+    builder->data = NULL;
+    builder->count = builder->capacity = 0;
+}
+
+bool string_builder_reserve(string_builder_t* builder, size_t count){
+    if(count > SIZE_MAX - 1 - builder->count) return false;
+
+    const size_t required = builder->count + count + 1;
+    if(required <= builder->capacity) return true;
+
+    if(!builder->owned){
+        builder->overflow = true;
+        return false;
+    }
+
+    size_t capacity = (builder->capacity > 0) ? builder->capacity : 16;
+    while(capacity < required) capacity = (capacity > SIZE_MAX / 2) ? required : capacity * 2;
+
+    char* data = STRING_VIEW_REALLOC(builder->data, capacity);
+    if(data == NULL) return false;
+
+    builder->data = data;
+    builder->capacity = capacity;
+    return true;
+}
+
+void string_builder_clear(string_builder_t* builder){
+    builder->count = 0;
+    builder->overflow = false;
+    if(builder->capacity > 0) builder->data[0] = '\0';
+}
+
+string_view_t string_builder_view(const string_builder_t* builder){
+    return (builder->count > 0) ? new_string_view(builder->data, builder->count) : STRING_VIEW_EMPTY;
+}
+
+bool string_builder_append(string_builder_t* builder, string_view_t sv){
+    if(!string_builder_reserve(builder, sv.count)) return false;
+
+    if(sv.count > 0) memcpy(builder->data + builder->count, sv.data, sv.count);
+    builder->count += sv.count;
+    builder->data[builder->count] = '\0';
+    return true;
+}
+
+bool string_builder_append_char(string_builder_t* builder, char c){
+    if(!string_builder_reserve(builder, 1)) return false;
+
+    builder->data[builder->count++] = c;
+    builder->data[builder->count] = '\0';
+    return true;
+}
+
+bool string_builder_append_uint(string_builder_t* builder, uint64_t value){
+    char digits[20];
+    char* end = digits + sizeof(digits);
+    const char* begin = string_view__format_u64(end, value);
+
+    return string_builder_append(builder, new_string_view(begin, (size_t)(end - begin)));
+}
+
+bool string_builder_append_int(string_builder_t* builder, int64_t value){
+    char digits[21];
+    char* end = digits + sizeof(digits);
+    const uint64_t magnitude = (value < 0) ? 0 - (uint64_t)value : (uint64_t)value;
+    char* begin = string_view__format_u64(end, magnitude);
+
+    if(value < 0) *--begin = '-';
+    return string_builder_append(builder, new_string_view(begin, (size_t)(end - begin)));
+}
+
+static bool string_view__join_size(const string_view_t* views, size_t count, string_view_t separator, size_t* total){
+    *total = 0;
+
+    for(size_t i = 0; i < count; i++){
+        const size_t piece = views[i].count + ((i > 0) ? separator.count : 0);
+        if(piece < views[i].count || piece > SIZE_MAX - 1 - *total) return false;
+        *total += piece;
+    }
+
+    return true;
+}
+
+static void string_view__join_into(char* out, const string_view_t* views, size_t count, string_view_t separator){
+    for(size_t i = 0; i < count; i++){
+        if(i > 0 && separator.count > 0){
+            memcpy(out, separator.data, separator.count);
+            out += separator.count;
+        }
+        if(views[i].count > 0){
+            memcpy(out, views[i].data, views[i].count);
+            out += views[i].count;
+        }
+    }
+
+    *out = '\0';
+}
+
+bool string_builder_append_join(string_builder_t* builder, const string_view_t* views, size_t count,
+                                string_view_t separator){
+    size_t total;
+
+    if(!string_view__join_size(views, count, separator, &total)) return false;
+    if(!string_builder_reserve(builder, total)) return false;
+
+    string_view__join_into(builder->data + builder->count, views, count, separator);
+    builder->count += total;
+    return true;
+}
+
+string_view_t string_view_join(const string_view_t* views, size_t count, string_view_t separator){
+    size_t total;
+
+    if(!string_view__join_size(views, count, separator, &total)) return new_string_view(NULL, 0);
+
+    char* data = STRING_VIEW_MALLOC(total + 1);
+    if(data == NULL) return new_string_view(NULL, 0);
+
+    string_view__join_into(data, views, count, separator);
+    return new_string_view(data, total);
+}
+
+/*
+ * Numeric parsing.
+ *
+ * Integers are accumulated eight digits at a time with SWAR arithmetic. Floats follow the
+ * fast_float design: Clinger's exact fast path, then the Eisel-Lemire algorithm with 128-bit
+ * approximations of the powers of five, and, when more than 19 significant digits leave the rounding
+ * undecided, an exact big integer comparison against the halfway point.
+ */
+
+#define STRING_VIEW__F64_MIN_POW10 (-342)
+#define STRING_VIEW__F64_MAX_POW10 308
+#define STRING_VIEW__F64_INFINITE_POWER 0x7FF
+#define STRING_VIEW__F64_MANTISSA_BITS 52
+#define STRING_VIEW__MAX_DIGITS 768
+#define STRING_VIEW__BIGINT_LIMBS 128
+
+/*
+ * The 128 most significant bits of 5^q for q in [-342, 308], truncated for q >= 0 and rounded up
+ * for q < 0, two 64-bit words per power (high word first). Generated with the fast_float script.
+ */
+static const uint64_t string_view__pow5_128[2 * (STRING_VIEW__F64_MAX_POW10 - STRING_VIEW__F64_MIN_POW10 + 1)] = {
+    0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+    0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+    0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+    0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+    0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+    0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+    0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+    0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+    0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+    0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+    0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+    0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+    0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+    0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+    0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+    0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+    0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+    0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+    0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+    0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+    0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+    0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+    0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+    0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+    0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+    0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+    0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+    0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL
+};
+
+static const double string_view__exact_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool string_view__is_digit(char c){
+    return (unsigned char)(c - '0') < 10;
+}
+
+static inline uint64_t string_view__load_digits(const char* p){
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static inline bool string_view__is_eight_digits(uint64_t chunk){
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL)
+            | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+/* Converts eight ASCII digits (first digit in the lowest byte) with three multiplications. */
+static inline uint64_t string_view__eight_digits(uint64_t chunk){
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 100 + (1000000ULL << 32);
+    const uint64_t mul2 = 1 + (10000ULL << 32);
+
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    return (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+}
+
+/* Accumulates the digits in [p, end) into `value` (modulo 2^64) and returns the first non-digit. */
+static const char* string_view__accumulate_digits(const char* p, const char* end, uint64_t* value){
+    uint64_t result = *value;
+
+    while(end - p >= 8){
+        const uint64_t chunk = string_view__load_digits(p);
+        if(!string_view__is_eight_digits(chunk)) break;
+        result = result * 100000000 + string_view__eight_digits(chunk);
+        p += 8;
+    }
+
+    while(p < end && string_view__is_digit(*p)){
+        result = result * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+
+    *value = result;
+    return p;
+}
+
+static const char* string_view__skip_digits(const char* p, const char* end){
+    while(end - p >= 8 && string_view__is_eight_digits(string_view__load_digits(p))) p += 8;
+    while(p < end && string_view__is_digit(*p)) p++;
+    return p;
+}
+
+/* Parses the digits at `p` as an unsigned magnitude, reporting overflow instead of wrapping. */
+static const char* string_view__parse_magnitude(const char* p, const char* end, uint64_t* value, bool* overflow){
+    uint64_t result = 0;
+
+    while(p < end && *p == '0') p++;
+
+    /* Up to 19 digits cannot overflow. */
+    const char* limit = (end - p > 19) ? p + 19 : end;
+    p = string_view__accumulate_digits(p, limit, &result);
+
+    *overflow = false;
+    if(p == limit && p < end && string_view__is_digit(*p)){
+        const uint64_t digit = (uint64_t)(*p - '0');
+        *overflow = result > (UINT64_MAX - digit) / 10;
+        result = result * 10 + digit;
+        p = string_view__skip_digits(p + 1, end);
+        *overflow = *overflow || (p - limit > 1);
+    }
+
+    *value = result;
+    return p;
+}
+
+string_view_parse_result_t string_view_parse_u64(string_view_t sv, uint64_t* value){
+    string_view_parse_result_t result = { 0, STRING_VIEW_PARSE_INVALID };
+    const char* begin = sv.data;
+    const char* end = sv.data + sv.count;
+    const char* p = begin;
+    uint64_t magnitude;
+    bool overflow;
+
+    if(p < end && *p == '+') p++;
+    if(p == end || !string_view__is_digit(*p)) return result;
+
+    p = string_view__parse_magnitude(p, end, &magnitude, &overflow);
+    *value = overflow ? UINT64_MAX : magnitude;
+    result.consumed = (size_t)(p - begin);
+    result.status = overflow ? STRING_VIEW_PARSE_OUT_OF_RANGE : STRING_VIEW_PARSE_OK;
+    return result;
+}
+
+string_view_parse_result_t string_view_parse_i64(string_view_t sv, int64_t* value){
+    string_view_parse_result_t result = { 0, STRING_VIEW_PARSE_INVALID };
+    const char* begin = sv.data;
+    const char* end = sv.data + sv.count;
+    const char* p = begin;
+    uint64_t magnitude;
+    bool overflow;
+    bool negative = false;
+
+    if(p < end && (*p == '+' || *p == '-')) negative = (*p++ == '-');
+    if(p == end || !string_view__is_digit(*p)) return result;
+
+    p = string_view__parse_magnitude(p, end, &magnitude, &overflow);
+
+    const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    overflow = overflow || magnitude > limit;
+
+    if(overflow) *value = negative ? INT64_MIN : INT64_MAX;
+    else if(negative) *value = (magnitude == limit) ? INT64_MIN : -(int64_t)magnitude;
+    else *value = (int64_t)magnitude;
+
+    result.consumed = (size_t)(p - begin);
+    result.status = overflow ? STRING_VIEW_PARSE_OUT_OF_RANGE : STRING_VIEW_PARSE_OK;
+    return result;
+}
+
+typedef struct {
+    const char* integer;
+    size_t integer_count;
+    const char* fraction;
+    size_t fraction_count;
+    int64_t exponent;
+    uint64_t mantissa;
+    int64_t power10;
+    bool too_many_digits;
+} string_view__decimal_t;
+
+typedef struct {
+    uint64_t mantissa;
+    int32_t power2;
+} string_view__adjusted_t;
+
+/* floor(log2(10^q)) + 63 for q in [-342, 308]. */
+static inline int32_t string_view__pow10_power2(int64_t q){
+    const int64_t scaled = (152170 + 65536) * q;
+    const int64_t floor_log2 = (scaled >= 0) ? scaled >> 16 : -((-scaled + 65535) >> 16);
+    return (int32_t)floor_log2 + 63;
+}
+
+/* Eisel-Lemire: rounds w * 10^q to a double, exactly when w is the full decimal significand. */
+static string_view__adjusted_t string_view__eisel_lemire(int64_t q, uint64_t w){
+    string_view__adjusted_t answer = { 0, 0 };
+
+    if(w == 0 || q < STRING_VIEW__F64_MIN_POW10) return answer;
+    if(q > STRING_VIEW__F64_MAX_POW10){
+        answer.power2 = STRING_VIEW__F64_INFINITE_POWER;
+        return answer;
+    }
+
+    const int lz = string_view__clz64(w);
+    const size_t index = 2 * (size_t)(q - STRING_VIEW__F64_MIN_POW10);
+    uint64_t low = w << lz, high = string_view__pow5_128[index];
+
+    string_view__mum(&low, &high);
+    if((high & 0x1FF) == 0x1FF){
+        uint64_t low2 = w << lz, high2 = string_view__pow5_128[index + 1];
+        string_view__mum(&low2, &high2);
+        low += high2;
+        if(high2 > low) high++;
+    }
+
+    const int upperbit = (int)(high >> 63);
+    const int shift = upperbit + 64 - STRING_VIEW__F64_MANTISSA_BITS - 3;
+
+    answer.mantissa = high >> shift;
+    answer.power2 = string_view__pow10_power2(q) + upperbit - lz + 1023;
+
+    if(answer.power2 <= 0){
+        if(-answer.power2 + 1 >= 64){
+            answer.mantissa = 0;
+            answer.power2 = 0;
+            return answer;
+        }
+
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = (answer.mantissa < (1ULL << STRING_VIEW__F64_MANTISSA_BITS)) ? 0 : 1;
+        return answer;
+    }
+
+    /* Exactly halfway between two doubles: round to even instead of up. */
+    if(low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1
+       && (answer.mantissa << shift) == high){
+        answer.mantissa &= ~1ULL;
+    }
+
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if(answer.mantissa >= (2ULL << STRING_VIEW__F64_MANTISSA_BITS)){
+        answer.mantissa = 1ULL << STRING_VIEW__F64_MANTISSA_BITS;
+        answer.power2++;
+    }
+
+    answer.mantissa &= ~(1ULL << STRING_VIEW__F64_MANTISSA_BITS);
+    if(answer.power2 >= STRING_VIEW__F64_INFINITE_POWER){
+        answer.power2 = STRING_VIEW__F64_INFINITE_POWER;
+        answer.mantissa = 0;
+    }
+
+    return answer;
+}
+
+typedef struct {
+    uint32_t limbs[STRING_VIEW__BIGINT_LIMBS];
+    size_t count;
+} string_view__bigint_t;
+
+static void string_view__bigint_mul_add(string_view__bigint_t* n, uint32_t multiplier, uint32_t addend){
+    uint64_t carry = addend;
+
+    for(size_t i = 0; i < n->count; i++){
+        const uint64_t product = (uint64_t)n->limbs[i] * multiplier + carry;
+        n->limbs[i] = (uint32_t)product;
+        carry = product >> 32;
+    }
+
+    if(carry != 0 && n->count < STRING_VIEW__BIGINT_LIMBS) n->limbs[n->count++] = (uint32_t)carry;
+}
+
+static void string_view__bigint_mul_pow5(string_view__bigint_t* n, size_t exponent){
+    static const uint32_t small[14] = {
+        1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625, 1220703125
+    };
+
+    for(; exponent >= 13; exponent -= 13) string_view__bigint_mul_add(n, small[13], 0);
+    if(exponent > 0) string_view__bigint_mul_add(n, small[exponent], 0);
+}
+
+static void string_view__bigint_shift_left(string_view__bigint_t* n, size_t bits){
+    const size_t words = bits / 32, rest = bits % 32;
+
+    if(n->count == 0) return;
+    if(n->count + words + 1 > STRING_VIEW__BIGINT_LIMBS) return;
+
+    n->limbs[n->count] = 0;
+    for(size_t i = n->count + 1; i-- > 0;){
+        uint32_t limb = (rest == 0) ? n->limbs[i] : (n->limbs[i] << rest);
+        if(rest != 0 && i > 0) limb |= n->limbs[i - 1] >> (32 - rest);
+        n->limbs[i + words] = limb;
+    }
+
+    memset(n->limbs, 0, words * sizeof(uint32_t));
+    n->count += words + 1;
+    while(n->count > 0 && n->limbs[n->count - 1] == 0) n->count--;
+}
+
+static int string_view__bigint_compare(const string_view__bigint_t* a, const string_view__bigint_t* b){
+    if(a->count != b->count) return (a->count < b->count) ? -1 : 1;
+
+    for(size_t i = a->count; i-- > 0;){
+        if(a->limbs[i] != b->limbs[i]) return (a->limbs[i] < b->limbs[i]) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Decides between `lower` and the next double by comparing all the significant digits (up to 768,
+ * the rest only breaking ties) against the halfway point, as exact big integers.
+ */
+static string_view__adjusted_t string_view__round_decimal(const string_view__decimal_t* decimal,
+                                                          string_view__adjusted_t lower){
+    static const uint32_t pow10[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    string_view__bigint_t digits = { {0}, 0 }, halfway = { {0}, 0 };
+    const char* parts[2] = { decimal->integer, decimal->fraction };
+    const size_t counts[2] = { decimal->integer_count, decimal->fraction_count };
+    size_t taken = 0, skipped = 0, pending = 0;
+    uint32_t chunk = 0;
+    bool leading = true, sticky = false;
+
+    for(size_t part = 0; part < 2; part++){
+        for(size_t i = 0; i < counts[part]; i++){
+            const uint32_t digit = (uint32_t)(parts[part][i] - '0');
+
+            if(leading && digit == 0) continue;
+            leading = false;
+
+            if(taken == STRING_VIEW__MAX_DIGITS){
+                sticky = sticky || digit != 0;
+                skipped++;
+                continue;
+            }
+
+            chunk = chunk * 10 + digit;
+            taken++;
+            if(++pending == 9){
+                string_view__bigint_mul_add(&digits, pow10[9], chunk);
+                chunk = 0;
+                pending = 0;
+            }
+        }
+    }
+    if(pending > 0) string_view__bigint_mul_add(&digits, pow10[pending], chunk);
+
+    /* value = digits * 10^e10, halfway = (2m + 1) * 2^(e2 - 1) */
+    const int64_t e10 = decimal->exponent - (int64_t)decimal->fraction_count + (int64_t)skipped;
+    const uint64_t m = (lower.power2 == 0) ? lower.mantissa : (lower.mantissa | (1ULL << STRING_VIEW__F64_MANTISSA_BITS));
+    const int64_t e2 = ((lower.power2 == 0) ? 1 : lower.power2) - 1075;
+    const uint64_t odd = 2 * m + 1;
+
+    halfway.limbs[0] = (uint32_t)odd;
+    halfway.limbs[1] = (uint32_t)(odd >> 32);
+    halfway.count = (halfway.limbs[1] != 0) ? 2 : 1;
+
+    if(e10 >= 0) string_view__bigint_mul_pow5(&digits, (size_t)e10);
+    else string_view__bigint_mul_pow5(&halfway, (size_t)-e10);
+
+    const int64_t shift = e10 - (e2 - 1);
+    if(shift >= 0) string_view__bigint_shift_left(&digits, (size_t)shift);
+    else string_view__bigint_shift_left(&halfway, (size_t)-shift);
+
+    const int order = string_view__bigint_compare(&digits, &halfway);
+    if(order < 0 || (order == 0 && !sticky && (m & 1) == 0)) return lower;
+
+    /* Round up to the next double; the mantissa carries into the exponent (up to infinity). */
+    string_view__adjusted_t upper = lower;
+    upper.mantissa++;
+    if(upper.mantissa == (1ULL << STRING_VIEW__F64_MANTISSA_BITS)){
+        upper.mantissa = 0;
+        upper.power2++;
+    }
+    return upper;
+}
+
+static inline double string_view__make_f64(uint64_t mantissa, uint64_t power2, bool negative){
+    const uint64_t bits = mantissa | (power2 << STRING_VIEW__F64_MANTISSA_BITS) | ((uint64_t)negative << 63);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static size_t string_view__match_word(const char* p, const char* end, const char* word){
+    size_t i = 0;
+
+    for(; word[i] != '\0'; i++){
+        if(p + i == end || (p[i] | 0x20) != word[i]) return 0;
+    }
+
+    return i;
+}
+
+string_view_parse_result_t string_view_parse_f64(string_view_t sv, double* value){
+    string_view_parse_result_t result = { 0, STRING_VIEW_PARSE_INVALID };
+    string_view__decimal_t decimal = { NULL, 0, NULL, 0, 0, 0, 0, false };
+    const char* begin = sv.data;
+    const char* end = sv.data + sv.count;
+    const char* p = begin;
+    bool negative = false;
+
+    if(p < end && (*p == '+' || *p == '-')) negative = (*p++ == '-');
+
+    if(p < end && !string_view__is_digit(*p) && *p != '.'){
+        size_t length;
+
+        if((length = string_view__match_word(p, end, "nan")) != 0){
+            *value = string_view__make_f64(1ULL << 51, STRING_VIEW__F64_INFINITE_POWER, negative);
+        }else if((length = string_view__match_word(p, end, "inf")) != 0){
+            length += string_view__match_word(p + length, end, "inity");
+            *value = string_view__make_f64(0, STRING_VIEW__F64_INFINITE_POWER, negative);
+        }else{
+            return result;
+        }
+
+        result.consumed = (size_t)(p + length - begin);
+        result.status = STRING_VIEW_PARSE_OK;
+        return result;
+    }
+
+    decimal.integer = p;
+    p = string_view__accumulate_digits(p, end, &decimal.mantissa);
+    decimal.integer_count = (size_t)(p - decimal.integer);
+
+    if(p < end && *p == '.'){
+        decimal.fraction = ++p;
+        p = string_view__accumulate_digits(p, end, &decimal.mantissa);
+        decimal.fraction_count = (size_t)(p - decimal.fraction);
+    }
+
+    if(decimal.integer_count + decimal.fraction_count == 0) return result;
+
+    if(p < end && (*p == 'e' || *p == 'E')){
+        const char* q = p + 1;
+        bool negative_exponent = false;
+
+        if(q < end && (*q == '+' || *q == '-')) negative_exponent = (*q++ == '-');
+        if(q < end && string_view__is_digit(*q)){
+            for(; q < end && string_view__is_digit(*q); q++){
+                if(decimal.exponent < 0x10000000) decimal.exponent = decimal.exponent * 10 + (*q - '0');
+            }
+            if(negative_exponent) decimal.exponent = -decimal.exponent;
+            p = q;
+        }
+    }
+
+    decimal.power10 = decimal.exponent - (int64_t)decimal.fraction_count;
+
+    if(decimal.integer_count + decimal.fraction_count > 19){
+        /* Leading zeros are not significant. */
+        size_t digits = decimal.integer_count + decimal.fraction_count;
+        for(const char* z = decimal.integer; z < p && (*z == '0' || *z == '.') && digits > 0; z++){
+            if(*z == '0') digits--;
+        }
+
+        if(digits > 19){
+            const char* q = decimal.integer;
+            const char* integer_end = decimal.integer + decimal.integer_count;
+            uint64_t mantissa = 0;
+
+            decimal.too_many_digits = true;
+            while(mantissa < 1000000000000000000ULL && q != integer_end) mantissa = mantissa * 10 + (uint64_t)(*q++ - '0');
+
+            if(mantissa >= 1000000000000000000ULL){
+                decimal.power10 = (int64_t)(integer_end - q) + decimal.exponent;
+            }else{
+                const char* fraction_end = decimal.fraction + decimal.fraction_count;
+                q = decimal.fraction;
+                while(mantissa < 1000000000000000000ULL && q != fraction_end) mantissa = mantissa * 10 + (uint64_t)(*q++ - '0');
+                decimal.power10 = decimal.exponent - (int64_t)(q - decimal.fraction);
+            }
+            decimal.mantissa = mantissa;
+        }
+    }
+
+    result.consumed = (size_t)(p - begin);
+    result.status = STRING_VIEW_PARSE_OK;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    /* Clinger: both operands are exact doubles, so a single rounding gives the correct result. */
+    if(!decimal.too_many_digits && decimal.power10 >= -22 && decimal.power10 <= 22
+       && decimal.mantissa <= (1ULL << 53)){
+        double fast = (double)decimal.mantissa;
+        fast = (decimal.power10 < 0) ? fast / string_view__exact_pow10[-decimal.power10]
+                                     : fast * string_view__exact_pow10[decimal.power10];
+        *value = negative ? -fast : fast;
+        return result;
+    }
+#endif
+
+    string_view__adjusted_t answer = string_view__eisel_lemire(decimal.power10, decimal.mantissa);
+    if(decimal.too_many_digits){
+        const string_view__adjusted_t upper = string_view__eisel_lemire(decimal.power10, decimal.mantissa + 1);
+        if(upper.mantissa != answer.mantissa || upper.power2 != answer.power2){
+            answer = string_view__round_decimal(&decimal, answer);
+        }
+    }
+
+    if(answer.power2 == STRING_VIEW__F64_INFINITE_POWER
+       || (answer.power2 == 0 && answer.mantissa == 0 && decimal.mantissa != 0)){
+        result.status = STRING_VIEW_PARSE_OUT_OF_RANGE;
+    }
+
+    *value = string_view__make_f64(answer.mantissa, (uint64_t)answer.power2, negative);
+    return result;
+}
+
+size_t string_view_parse_i64_batch(const string_view_t* views, size_t count, int64_t* values){
+    for(size_t i = 0; i < count; i++){
+        const string_view_parse_result_t result = string_view_parse_i64(views[i], &values[i]);
+        if(result.status != STRING_VIEW_PARSE_OK || result.consumed != views[i].count) return i;
+    }
+
+    return count;
+}
+
+size_t string_view_parse_u64_batch(const string_view_t* views, size_t count, uint64_t* values){
+    for(size_t i = 0; i < count; i++){
+        const string_view_parse_result_t result = string_view_parse_u64(views[i], &values[i]);
+        if(result.status != STRING_VIEW_PARSE_OK || result.consumed != views[i].count) return i;
+    }
+
+    return count;
+}
+
+size_t string_view_parse_f64_batch(const string_view_t* views, size_t count, double* values){
+    for(size_t i = 0; i < count; i++){
+        const string_view_parse_result_t result = string_view_parse_f64(views[i], &values[i]);
+        if(result.status != STRING_VIEW_PARSE_OK || result.consumed != views[i].count) return i;
+    }
+
+    return count;
+}
+
+#ifdef STRING_VIEW_HAS_THREADS
+#define STRING_VIEW__PARALLEL_CHUNK ((size_t)1 << 20)
+#define STRING_VIEW__PARALLEL_BUFFER 512
+
+struct string_view__thread_pool_state {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_mutex_t run_lock;
+    pthread_t* threads;
+    size_t worker_count;
+    void (*task)(void* context, size_t index);
+    void* context;
+    size_t task_count;
+    size_t next_task;
+    size_t finished;
+    bool stop;
+};
+
+/* Claims and runs tasks of the current job until none is left. Called with the lock held. */
+static void string_view__pool_drain(struct string_view__thread_pool_state* state){
+    while(state->next_task < state->task_count){
+        const size_t index = state->next_task++;
+
+        pthread_mutex_unlock(&state->lock);
+        state->task(state->context, index);
+        pthread_mutex_lock(&state->lock);
+
+        if(++state->finished == state->task_count) pthread_cond_signal(&state->done);
+    }
+}
+
+static void* string_view__pool_worker(void* argument){
+    struct string_view__thread_pool_state* state = argument;
+
+    pthread_mutex_lock(&state->lock);
+    while(!state->stop){
+        if(state->next_task < state->task_count) string_view__pool_drain(state);
+        else pthread_cond_wait(&state->wake, &state->lock);
+    }
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+/* Runs `task(context, i)` for every i in [0, task_count) on the pool and the calling thread. */
+static void string_view__pool_run(string_view_thread_pool_t* pool, void (*task)(void*, size_t), void* context,
+                                  size_t task_count){
+    struct string_view__thread_pool_state* state = pool->state;
+
+    pthread_mutex_lock(&state->run_lock);
+    pthread_mutex_lock(&state->lock);
+
+    state->task = task;
+    state->context = context;
+    state->task_count = task_count;
+    state->next_task = 0;
+    state->finished = 0;
+    pthread_cond_broadcast(&state->wake);
+
+    string_view__pool_drain(state);
+    while(state->finished < state->task_count) pthread_cond_wait(&state->done, &state->lock);
+
+    pthread_mutex_unlock(&state->lock);
+    pthread_mutex_unlock(&state->run_lock);
+}
+
+bool string_view_thread_pool_init(string_view_thread_pool_t* pool, size_t thread_count){
+    struct string_view__thread_pool_state* state;
+
+    if(thread_count == 0){
+#ifdef _SC_NPROCESSORS_ONLN
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = (online > 0) ? (size_t)online : 1;
+#else
+        thread_count = 1;
+#endif
+    }
+
+    pool->state = NULL;
+    pool->thread_count = 0;
+
+    state = STRING_VIEW_CALLOC(1, sizeof(*state));
+    if(state == NULL) return false;
+
+    state->threads = STRING_VIEW_CALLOC(thread_count, sizeof(pthread_t));
+    if(state->threads == NULL){
+        STRING_VIEW_FREE(state);
+        return false;
+    }
+
+    pthread_mutex_init(&state->lock, NULL);
+    pthread_mutex_init(&state->run_lock, NULL);
+    pthread_cond_init(&state->wake, NULL);
+    pthread_cond_init(&state->done, NULL);
+
+    pool->state = state;
+    pool->thread_count = thread_count;
+
+    for(size_t i = 0; i + 1 < thread_count; i++){
+        if(pthread_create(&state->threads[i], NULL, string_view__pool_worker, state) != 0){
+            string_view_thread_pool_free(pool);
+            return false;
+        }
+        state->worker_count++;
+    }
+
+    return true;
+}
+
+void string_view_thread_pool_free(string_view_thread_pool_t* pool){
+    struct string_view__thread_pool_state* state = pool->state;
+
+    if(state == NULL) return;
+
+    pthread_mutex_lock(&state->lock);
+    state->stop = true;
+    pthread_cond_broadcast(&state->wake);
+    pthread_mutex_unlock(&state->lock);
+
+    for(size_t i = 0; i < state->worker_count; i++) pthread_join(state->threads[i], NULL);
+
+    pthread_mutex_destroy(&state->lock);
+    pthread_mutex_destroy(&state->run_lock);
+    pthread_cond_destroy(&state->wake);
+    pthread_cond_destroy(&state->done);
+    STRING_VIEW_FREE(state->threads);
+    STRING_VIEW_FREE(state);
+
+    pool->state = NULL;
+    pool->thread_count = 0;
+}
+
+typedef struct {
+    string_view_searcher_t searcher;
+    string_view_t haystack;
+    size_t task_count;
+    pthread_mutex_t lock;
+    size_t first;
+    size_t* counts;
+    size_t** positions;
+} string_view__parallel_job_t;
+
+/* The chunk of task `index`, extended by `needle.count - 1` bytes to catch occurrences across its end. */
+static string_view_t string_view__parallel_window(const string_view__parallel_job_t* job, size_t index){
+    const size_t start = index * STRING_VIEW__PARALLEL_CHUNK;
+    const size_t overlap = job->searcher.needle.count - 1;
+    size_t end = start + STRING_VIEW__PARALLEL_CHUNK;
+
+    end = (end > job->haystack.count - overlap) ? job->haystack.count : end + overlap;
+    return new_string_view(job->haystack.data + start, end - start);
+}
+
+static void string_view__parallel_find_task(void* context, size_t index){
+    string_view__parallel_job_t* job = context;
+    const size_t start = index * STRING_VIEW__PARALLEL_CHUNK;
+
+    pthread_mutex_lock(&job->lock);
+    const bool skip = job->first <= start;
+    pthread_mutex_unlock(&job->lock);
+    if(skip) return;
+
+    const size_t pos = string_view_searcher_find(&job->searcher, string_view__parallel_window(job, index), 0);
+    if(pos == STRING_VIEW_NPOS) return;
+
+    pthread_mutex_lock(&job->lock);
+    if(start + pos < job->first) job->first = start + pos;
+    pthread_mutex_unlock(&job->lock);
+}
+
+static void string_view__parallel_count_task(void* context, size_t index){
+    string_view__parallel_job_t* job = context;
+    const string_view_t window = string_view__parallel_window(job, index);
+
+    job->counts[index] = (job->searcher.needle.count == 1)
+        ? string_view_count_char(window, job->searcher.needle.data[0])
+        : string_view_searcher_find_all(&job->searcher, window, NULL, 0);
+}
+
+static void string_view__parallel_find_all_task(void* context, size_t index){
+    string_view__parallel_job_t* job = context;
+    const string_view_t window = string_view__parallel_window(job, index);
+    size_t buffer[STRING_VIEW__PARALLEL_BUFFER];
+
+    const size_t count = string_view_searcher_find_all(&job->searcher, window, buffer, STRING_VIEW__PARALLEL_BUFFER);
+    size_t* positions = NULL;
+
+    /* A non-empty needle matches at most once per byte of the window, which bounds the allocation. */
+    if(count > 0 && count <= window.count && count <= SIZE_MAX / sizeof(size_t)){
+        positions = STRING_VIEW_MALLOC(count * sizeof(size_t));
+    }
+
+    if(positions != NULL){
+        if(count <= STRING_VIEW__PARALLEL_BUFFER) memcpy(positions, buffer, count * sizeof(size_t));
+        else string_view_searcher_find_all(&job->searcher, window, positions, count);
+    }
+
+    job->counts[index] = count;
+    job->positions[index] = positions;
+}
+
+static bool string_view__parallel_begin(string_view__parallel_job_t* job, string_view_thread_pool_t* pool,
+                                        string_view_t haystack, string_view_t needle){
+    if(pool->thread_count < 2 || needle.count == 0 || needle.count > haystack.count
+       || haystack.count < 2 * STRING_VIEW__PARALLEL_CHUNK){
+        return false;
+    }
+
+    job->searcher = new_string_view_searcher(needle);
+    job->haystack = haystack;
+    job->task_count = (haystack.count - needle.count) / STRING_VIEW__PARALLEL_CHUNK + 1;
+    job->first = STRING_VIEW_NPOS;
+    job->counts = NULL;
+    job->positions = NULL;
+    pthread_mutex_init(&job->lock, NULL);
+    return true;
+}
+
+size_t string_view_parallel_find_first(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle){
+    string_view__parallel_job_t job;
+
+    if(!string_view__parallel_begin(&job, pool, haystack, needle)) return string_view_find_substring(haystack, needle, 0);
+
+    string_view__pool_run(pool, string_view__parallel_find_task, &job, job.task_count);
+    pthread_mutex_destroy(&job.lock);
+    return job.first;
+}
+
+size_t string_view_parallel_count(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle){
+    string_view__parallel_job_t job;
+    size_t total = 0;
+
+    if(string_view__parallel_begin(&job, pool, haystack, needle)){
+        job.counts = STRING_VIEW_MALLOC(job.task_count * sizeof(size_t));
+        if(job.counts != NULL){
+            string_view__pool_run(pool, string_view__parallel_count_task, &job, job.task_count);
+            for(size_t i = 0; i < job.task_count; i++) total += job.counts[i];
+            STRING_VIEW_FREE(job.counts);
+            pthread_mutex_destroy(&job.lock);
+            return total;
+        }
+        pthread_mutex_destroy(&job.lock);
+    }
+
+    if(needle.count == 1) return string_view_count_char(haystack, needle.data[0]);
+
+    const string_view_searcher_t searcher = new_string_view_searcher(needle);
+    return string_view_searcher_find_all(&searcher, haystack, NULL, 0);
+}
+
+size_t string_view_parallel_find_all(string_view_thread_pool_t* pool, string_view_t haystack, string_view_t needle,
+                                     size_t* positions, size_t capacity){
+    string_view__parallel_job_t job;
+    size_t total = 0;
+
+    if(string_view__parallel_begin(&job, pool, haystack, needle)){
+        job.counts = STRING_VIEW_MALLOC(job.task_count * sizeof(size_t));
+        job.positions = STRING_VIEW_MALLOC(job.task_count * sizeof(size_t*));
+
+        if(job.counts != NULL && job.positions != NULL){
+            string_view__pool_run(pool, string_view__parallel_find_all_task, &job, job.task_count);
+
+            /* Merge in chunk order; a chunk whose buffer could not be allocated is scanned again here. */
+            for(size_t i = 0; i < job.task_count; i++){
+                const size_t start = i * STRING_VIEW__PARALLEL_CHUNK;
+                const size_t room = (total < capacity) ? capacity - total : 0;
+                const size_t stored = (job.counts[i] < room) ? job.counts[i] : room;
+
+                if(stored > 0){
+                    if(job.positions[i] != NULL){
+                        memcpy(&positions[total], job.positions[i], stored * sizeof(size_t));
+                    }else{
+                        string_view_searcher_find_all(&job.searcher, string_view__parallel_window(&job, i),
+                                                      &positions[total], stored);
+                    }
+                    for(size_t k = 0; k < stored; k++) positions[total + k] += start;
+                }
+
+                total += job.counts[i];
+                STRING_VIEW_FREE(job.positions[i]);
+            }
+
+            STRING_VIEW_FREE(job.counts);
+            STRING_VIEW_FREE(job.positions);
+            pthread_mutex_destroy(&job.lock);
+            return total;
+        }
+
+        STRING_VIEW_FREE(job.counts);
+        STRING_VIEW_FREE(job.positions);
+        pthread_mutex_destroy(&job.lock);
+    }
+
+    const string_view_searcher_t searcher = new_string_view_searcher(needle);
+    return string_view_searcher_find_all(&searcher, haystack, positions, capacity);
+}
+#endif
+
+/*
+ * Decodes the sequence at the start of `p[0..n)` following table 3-7 of the Unicode standard.
+ * On error, `*code_point` is U+FFFD and the length of the maximal ill-formed subpart is returned.
+ */
+static size_t string_view__utf8_decode(const unsigned char* p, size_t n, uint32_t* code_point, bool* valid){
+    const unsigned char lead = p[0];
+    unsigned char lo = 0x80, hi = 0xbf;
+    uint32_t cp;
+    size_t need;
+
+    *valid = false;
+    *code_point = 0xfffd;
+
+    if(lead < 0x80){
+        *valid = true;
+        *code_point = lead;
+        return 1;
+    }else if(lead < 0xc2){
+        return 1;
+    }else if(lead < 0xe0){
+        need = 1;
+        cp = lead & 0x1f;
+    }else if(lead < 0xf0){
+        need = 2;
+        cp = lead & 0x0f;
+        if(lead == 0xe0) lo = 0xa0;
+        if(lead == 0xed) hi = 0x9f;
+    }else if(lead < 0xf5){
+        need = 3;
+        cp = lead & 0x07;
+        if(lead == 0xf0) lo = 0x90;
+        if(lead == 0xf4) hi = 0x8f;
+    }else{
+        return 1;
+    }
+
+    for(size_t k = 1; k <= need; k++){
+        if(k >= n || p[k] < lo || p[k] > hi) return k;
+        cp = (cp << 6) | (p[k] & 0x3f);
+        lo = 0x80;
+        hi = 0xbf;
+    }
+
+    *valid = true;
+    *code_point = cp;
+    return need + 1;
+}
+
+static size_t string_view__utf8_validate_scalar(const unsigned char* p, size_t n){
+    size_t i = 0;
+    uint32_t cp;
+    bool valid;
+
+    while(i < n){
+        if(n - i >= 8){
+            uint64_t word;
+            memcpy(&word, &p[i], 8);
+            if((word & 0x8080808080808080ULL) == 0){
+                i += 8;
+                continue;
+            }
+        }
+
+        if(p[i] < 0x80){
+            i++;
+            continue;
+        }
+
+        const size_t length = string_view__utf8_decode(&p[i], n - i, &cp, &valid);
+        if(!valid) return i;
+        i += length;
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+/* Continuation bytes are the only ones below -64 as signed chars. */
+static size_t string_view__utf8_count_scalar(const char* s, size_t n){
+    size_t total = 0;
+
+    for(size_t i = 0; i < n; i++){
+        total += (signed char)s[i] > -65;
+    }
+
+    return total;
+}
+
+#ifdef STRING_VIEW__X86
+
+/*
+ * After a vector kernel flags the block starting at `i`, the exact offset is found by decoding from
+ * the first sequence that can reach into that block. Everything before it is already known to be valid.
+ */
+static size_t string_view__utf8_locate_error(const unsigned char* p, size_t n, size_t i){
+    size_t start = (i > 3) ? i - 3 : 0;
+
+    while(start < i && (p[start] & 0xc0) == 0x80) start++;
+
+    const size_t pos = string_view__utf8_validate_scalar(p + start, n - start);
+    return (pos == STRING_VIEW_NPOS) ? STRING_VIEW_NPOS : start + pos;
+}
+
+/* SSE2 has no byte shuffle, so it only skips the ASCII blocks and decodes the others. */
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__utf8_validate_sse2(const unsigned char* p, size_t n){
+    size_t i = 0;
+    uint32_t cp;
+    bool valid;
+
+    while(i + 16 <= n){
+        const size_t end = i + 16;
+        const unsigned mask = (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(p + i)));
+
+        if(mask == 0){
+            i = end;
+            continue;
+        }
+
+        i += (size_t)__builtin_ctz(mask);
+        while(i < end){
+            if(p[i] < 0x80){
+                i++;
+                continue;
+            }
+
+            const size_t length = string_view__utf8_decode(&p[i], n - i, &cp, &valid);
+            if(!valid) return i;
+            i += length;
+        }
+    }
+
+    const size_t pos = string_view__utf8_validate_scalar(p + i, n - i);
+    return (pos == STRING_VIEW_NPOS) ? STRING_VIEW_NPOS : i + pos;
+}
+
+/*
+ * The vector validators use the lookup algorithm of Keiser and Lemire. Each error class is a bit;
+ * three 16-entry tables indexed by the high nibble of the previous byte, its low nibble and the high
+ * nibble of the current byte each return the classes their nibble is compatible with, and a byte
+ * pair is wrong when a class survives the AND of the three. The third and fourth bytes of long
+ * sequences are checked separately against the leads two and three bytes back.
+ */
+#define STRING_VIEW__UTF8_TOO_SHORT   0x01
+#define STRING_VIEW__UTF8_TOO_LONG    0x02
+#define STRING_VIEW__UTF8_OVERLONG_3  0x04
+#define STRING_VIEW__UTF8_TOO_LARGE   0x08
+#define STRING_VIEW__UTF8_SURROGATE   0x10
+#define STRING_VIEW__UTF8_OVERLONG_2  0x20
+#define STRING_VIEW__UTF8_TOO_LARGE_1000 0x40
+#define STRING_VIEW__UTF8_OVERLONG_4  0x40
+#define STRING_VIEW__UTF8_TWO_CONTS   0x80
+#define STRING_VIEW__UTF8_CARRY (STRING_VIEW__UTF8_TOO_SHORT | STRING_VIEW__UTF8_TOO_LONG | STRING_VIEW__UTF8_TWO_CONTS)
+
+static const uint8_t string_view__utf8_byte_1_high[16] = {
+    STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG,
+    STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG, STRING_VIEW__UTF8_TOO_LONG,
+    STRING_VIEW__UTF8_TWO_CONTS, STRING_VIEW__UTF8_TWO_CONTS, STRING_VIEW__UTF8_TWO_CONTS, STRING_VIEW__UTF8_TWO_CONTS,
+    STRING_VIEW__UTF8_TOO_SHORT | STRING_VIEW__UTF8_OVERLONG_2,
+    STRING_VIEW__UTF8_TOO_SHORT,
+    STRING_VIEW__UTF8_TOO_SHORT | STRING_VIEW__UTF8_OVERLONG_3 | STRING_VIEW__UTF8_SURROGATE,
+    STRING_VIEW__UTF8_TOO_SHORT | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000 | STRING_VIEW__UTF8_OVERLONG_4
+};
+
+static const uint8_t string_view__utf8_byte_1_low[16] = {
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_OVERLONG_3 | STRING_VIEW__UTF8_OVERLONG_2 | STRING_VIEW__UTF8_OVERLONG_4,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_OVERLONG_2,
+    STRING_VIEW__UTF8_CARRY,
+    STRING_VIEW__UTF8_CARRY,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000 | STRING_VIEW__UTF8_SURROGATE,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000,
+    STRING_VIEW__UTF8_CARRY | STRING_VIEW__UTF8_TOO_LARGE | STRING_VIEW__UTF8_TOO_LARGE_1000
+};
+
+static const uint8_t string_view__utf8_byte_2_high[16] = {
+    STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT,
+    STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT,
+    STRING_VIEW__UTF8_TOO_LONG | STRING_VIEW__UTF8_OVERLONG_2 | STRING_VIEW__UTF8_TWO_CONTS | STRING_VIEW__UTF8_OVERLONG_3
+        | STRING_VIEW__UTF8_TOO_LARGE_1000 | STRING_VIEW__UTF8_OVERLONG_4,
+    STRING_VIEW__UTF8_TOO_LONG | STRING_VIEW__UTF8_OVERLONG_2 | STRING_VIEW__UTF8_TWO_CONTS | STRING_VIEW__UTF8_OVERLONG_3
+        | STRING_VIEW__UTF8_TOO_LARGE,
+    STRING_VIEW__UTF8_TOO_LONG | STRING_VIEW__UTF8_OVERLONG_2 | STRING_VIEW__UTF8_TWO_CONTS | STRING_VIEW__UTF8_SURROGATE
+        | STRING_VIEW__UTF8_TOO_LARGE,
+    STRING_VIEW__UTF8_TOO_LONG | STRING_VIEW__UTF8_OVERLONG_2 | STRING_VIEW__UTF8_TWO_CONTS | STRING_VIEW__UTF8_SURROGATE
+        | STRING_VIEW__UTF8_TOO_LARGE,
+    STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT, STRING_VIEW__UTF8_TOO_SHORT
+};
+
+/* A byte is an unfinished lead when it exceeds the limit for its distance to the end of the block. */
+static const uint8_t string_view__utf8_incomplete_limit[64] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xef, 0xdf, 0xbf
+};
+
+/* Shifts the byte stream `prev:input` so that each byte lines up with the one `n` positions before it. */
+#define STRING_VIEW__UTF8_PREV_AVX2(input, prev, n) \
+    _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+STRING_VIEW__TARGET_AVX2
+static inline __m256i string_view__utf8_errors_avx2(__m256i input, __m256i prev_input){
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_1_high));
+    const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_1_low));
+    const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_2_high));
+    const __m256i prev1 = STRING_VIEW__UTF8_PREV_AVX2(input, prev_input, 1);
+    const __m256i prev2 = STRING_VIEW__UTF8_PREV_AVX2(input, prev_input, 2);
+    const __m256i prev3 = STRING_VIEW__UTF8_PREV_AVX2(input, prev_input, 3);
+
+    const __m256i special = _mm256_and_si256(
+        _mm256_and_si256(_mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                         _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+    const __m256i must_continue = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xe0 - 0x80))),
+                                                  _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xf0 - 0x80))));
+
+    return _mm256_xor_si256(_mm256_and_si256(must_continue, _mm256_set1_epi8((char)0x80)), special);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__utf8_validate_avx2(const unsigned char* p, size_t n){
+    const __m256i limit = _mm256_loadu_si256((const __m256i*)(string_view__utf8_incomplete_limit + 32));
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+
+    while(i < n){
+        __m256i input;
+        __m256i error;
+
+        if(n - i >= 32){
+            input = _mm256_loadu_si256((const __m256i*)(p + i));
+        }else{
+            unsigned char tail[32] = {0};
+            memcpy(tail, p + i, n - i);
+            input = _mm256_loadu_si256((const __m256i*)tail);
+        }
+
+        if(_mm256_movemask_epi8(input) == 0){
+            error = prev_incomplete;
+            prev_incomplete = _mm256_setzero_si256();
+        }else{
+            error = string_view__utf8_errors_avx2(input, prev_input);
+            prev_incomplete = _mm256_subs_epu8(input, limit);
+        }
+
+        if(!_mm256_testz_si256(error, error)) return string_view__utf8_locate_error(p, n, i);
+        prev_input = input;
+        i += 32;
+    }
+
+    if(!_mm256_testz_si256(prev_incomplete, prev_incomplete)) return string_view__utf8_locate_error(p, n, n);
+    return STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_AVX512
+static inline __m512i string_view__utf8_errors_avx512(__m512i input, __m512i prev_input){
+    const __m512i nibble = _mm512_set1_epi8(0x0f);
+    const __m512i byte_1_high = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_1_high));
+    const __m512i byte_1_low = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_1_low));
+    const __m512i byte_2_high = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)string_view__utf8_byte_2_high));
+    const __m512i shifted = _mm512_alignr_epi64(input, prev_input, 6);
+    const __m512i prev1 = _mm512_alignr_epi8(input, shifted, 15);
+    const __m512i prev2 = _mm512_alignr_epi8(input, shifted, 14);
+    const __m512i prev3 = _mm512_alignr_epi8(input, shifted, 13);
+
+    const __m512i special = _mm512_and_si512(
+        _mm512_and_si512(_mm512_shuffle_epi8(byte_1_high, _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble)),
+                         _mm512_shuffle_epi8(byte_1_low, _mm512_and_si512(prev1, nibble))),
+        _mm512_shuffle_epi8(byte_2_high, _mm512_and_si512(_mm512_srli_epi16(input, 4), nibble)));
+    const __m512i must_continue = _mm512_or_si512(_mm512_subs_epu8(prev2, _mm512_set1_epi8((char)(0xe0 - 0x80))),
+                                                  _mm512_subs_epu8(prev3, _mm512_set1_epi8((char)(0xf0 - 0x80))));
+
+    return _mm512_xor_si512(_mm512_and_si512(must_continue, _mm512_set1_epi8((char)0x80)), special);
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__utf8_validate_avx512(const unsigned char* p, size_t n){
+    const __m512i limit = _mm512_loadu_si512((const void*)string_view__utf8_incomplete_limit);
+    __m512i prev_input = _mm512_setzero_si512();
+    __m512i prev_incomplete = _mm512_setzero_si512();
+    size_t i = 0;
+
+    while(i < n){
+        const __m512i input = (n - i >= 64)
+            ? _mm512_loadu_si512((const void*)(p + i))
+            : _mm512_maskz_loadu_epi8(string_view__tail_mask64(n - i), p + i);
+        __m512i error;
+
+        if(_mm512_movepi8_mask(input) == 0){
+            error = prev_incomplete;
+            prev_incomplete = _mm512_setzero_si512();
+        }else{
+            error = string_view__utf8_errors_avx512(input, prev_input);
+            prev_incomplete = _mm512_subs_epu8(input, limit);
+        }
+
+        if(_mm512_test_epi8_mask(error, error) != 0) return string_view__utf8_locate_error(p, n, i);
+        prev_input = input;
+        i += 64;
+    }
+
+    if(_mm512_test_epi8_mask(prev_incomplete, prev_incomplete) != 0) return string_view__utf8_locate_error(p, n, n);
+    return STRING_VIEW_NPOS;
+}
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__utf8_count_sse2(const char* s, size_t n){
+    const __m128i limit = _mm_set1_epi8(-65);
+    __m128i sums = _mm_setzero_si128();
+    uint64_t lanes[2];
+    size_t i = 0;
+
+    while(n - i >= 16){
+        const size_t blocks = ((n - i) / 16 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 16 : STRING_VIEW__COUNT_BLOCKS;
+        __m128i counters = _mm_setzero_si128();
+
+        for(size_t b = 0; b < blocks; b++, i += 16){
+            const __m128i block = _mm_loadu_si128((const __m128i*)(s + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, limit));
+        }
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(counters, _mm_setzero_si128()));
+    }
+
+    _mm_storeu_si128((__m128i*)lanes, sums);
+    return (size_t)(lanes[0] + lanes[1]) + string_view__utf8_count_scalar(s + i, n - i);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__utf8_count_avx2(const char* s, size_t n){
+    const __m256i limit = _mm256_set1_epi8(-65);
+    __m256i sums = _mm256_setzero_si256();
+    uint64_t lanes[4];
+    size_t i = 0;
+
+    while(n - i >= 32){
+        const size_t blocks = ((n - i) / 32 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 32 : STRING_VIEW__COUNT_BLOCKS;
+        __m256i counters = _mm256_setzero_si256();
+
+        for(size_t b = 0; b < blocks; b++, i += 32){
+            const __m256i block = _mm256_loadu_si256((const __m256i*)(s + i));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(block, limit));
+        }
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    }
+
+    _mm256_storeu_si256((__m256i*)lanes, sums);
+    return (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]) + string_view__utf8_count_sse2(s + i, n - i);
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__utf8_count_avx512(const char* s, size_t n){
+    const __m512i limit = _mm512_set1_epi8(-65);
+    __m512i sums = _mm512_setzero_si512();
+    size_t total = 0;
+    size_t i = 0;
+
+    while(n - i >= 64){
+        const size_t blocks = ((n - i) / 64 < STRING_VIEW__COUNT_BLOCKS) ? (n - i) / 64 : STRING_VIEW__COUNT_BLOCKS;
+        __m512i counters = _mm512_setzero_si512();
+
+        for(size_t b = 0; b < blocks; b++, i += 64){
+            const __mmask64 leads = _mm512_cmpgt_epi8_mask(_mm512_loadu_si512((const void*)(s + i)), limit);
+            counters = _mm512_sub_epi8(counters, _mm512_movm_epi8(leads));
+        }
+        sums = _mm512_add_epi64(sums, _mm512_sad_epu8(counters, _mm512_setzero_si512()));
+    }
+
+    if(i < n){
+        const __mmask64 valid = string_view__tail_mask64(n - i);
+        const __m512i block = _mm512_maskz_loadu_epi8(valid, s + i);
+        total += (size_t)_mm_popcnt_u64(_mm512_mask_cmpgt_epi8_mask(valid, block, limit));
+    }
+
+    return total + (size_t)_mm512_reduce_add_epi64(sums);
+}
+
+#endif
+
+static size_t string_view__utf8_count(const char* s, size_t n){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__utf8_count_avx512(s, n);
+    case STRING_VIEW_SIMD_AVX2: return string_view__utf8_count_avx2(s, n);
+    case STRING_VIEW_SIMD_SSE2: return string_view__utf8_count_sse2(s, n);
+#endif
+    default: return string_view__utf8_count_scalar(s, n);
+    }
+}
+
+/* Returns the offset of the lead byte of code point `k` of `s[0..n)`, or `n` if there are fewer code points. */
+static size_t string_view__utf8_advance(const char* s, size_t n, size_t k){
+    const size_t stride = 256;
+    size_t i = 0;
+
+    while(n - i >= stride){
+        const size_t leads = string_view__utf8_count(s + i, stride);
+        if(leads > k) break;
+        k -= leads;
+        i += stride;
+    }
+
+    for(; i < n; i++){
+        if((signed char)s[i] > -65){
+            if(k == 0) return i;
+            k--;
+        }
+    }
+
+    return n;
+}
+
+size_t string_view_utf8_validate(string_view_t sv){
+    const unsigned char* p = (const unsigned char*)sv.data;
+
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__utf8_validate_avx512(p, sv.count);
+    case STRING_VIEW_SIMD_AVX2: return string_view__utf8_validate_avx2(p, sv.count);
+    case STRING_VIEW_SIMD_SSE2: return string_view__utf8_validate_sse2(p, sv.count);
+#endif
+    default: return string_view__utf8_validate_scalar(p, sv.count);
+    }
+}
+
+size_t string_view_utf8_length(string_view_t sv){
+    return string_view__utf8_count(sv.data, sv.count);
+}
+
+string_view_t string_view_utf8_substr(string_view_t sv, size_t start, size_t count){
+    const size_t begin = string_view__utf8_advance(sv.data, sv.count, start);
+    if(begin == sv.count) return STRING_VIEW_EMPTY;
+
+    const size_t length = string_view__utf8_advance(sv.data + begin, sv.count - begin, count);
+    return new_string_view(&sv.data[begin], length);
+}
+
+inline string_view_utf8_iter_t new_string_view_utf8_iter(string_view_t sv){
+    return (string_view_utf8_iter_t) {
+        .rest = sv
+    };
+}
+
+bool string_view_utf8_next(string_view_utf8_iter_t* iter, uint32_t* code_point){
+    bool valid;
+
+    if(iter->rest.count == 0) return false;
+
+    const size_t length = string_view__utf8_decode((const unsigned char*)iter->rest.data, iter->rest.count, code_point, &valid);
+    iter->rest.data += length;
+    iter->rest.count -= length;
+    return true;
+}
+
+/* Each `*_csv_masks` kernel sets the bits of the quotes and of the separators of a 64-byte block. */
+static void string_view__csv_masks_scalar(const char* p, char delimiter, uint64_t* quotes, uint64_t* separators){
+    uint64_t q = 0, s = 0;
+
+    for(size_t i = 0; i < 64; i++){
+        q |= (uint64_t)(p[i] == '"') << i;
+        s |= (uint64_t)(p[i] == delimiter || p[i] == '\n') << i;
+    }
+
+    *quotes = q;
+    *separators = s;
+}
+
+#ifdef STRING_VIEW__X86
+
+STRING_VIEW__TARGET_SSE2
+static void string_view__csv_masks_sse2(const char* p, char delimiter, uint64_t* quotes, uint64_t* separators){
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i delim = _mm_set1_epi8(delimiter);
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t q = 0, s = 0;
+
+    for(size_t i = 0; i < 64; i += 16){
+        const __m128i block = _mm_loadu_si128((const __m128i*)(p + i));
+        q |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, quote)) << i;
+        s |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, delim),
+                                                                _mm_cmpeq_epi8(block, newline))) << i;
+    }
+
+    *quotes = q;
+    *separators = s;
+}
+
+STRING_VIEW__TARGET_AVX2
+static void string_view__csv_masks_avx2(const char* p, char delimiter, uint64_t* quotes, uint64_t* separators){
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i delim = _mm256_set1_epi8(delimiter);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    const __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+
+    *quotes = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, quote))
+        | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, quote)) << 32);
+    *separators = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(lo, delim),
+                                                                           _mm256_cmpeq_epi8(lo, newline)))
+        | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(hi, delim),
+                                                                    _mm256_cmpeq_epi8(hi, newline))) << 32);
+}
+
+STRING_VIEW__TARGET_AVX512
+static void string_view__csv_masks_avx512(const char* p, char delimiter, uint64_t* quotes, uint64_t* separators){
+    const __m512i block = _mm512_loadu_si512((const void*)p);
+
+    *quotes = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('"'));
+    *separators = _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8(delimiter))
+        | _mm512_cmpeq_epi8_mask(block, _mm512_set1_epi8('\n'));
+}
+
+#endif
+
+static inline void string_view__csv_masks(const char* p, char delimiter, uint64_t* quotes, uint64_t* separators){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: string_view__csv_masks_avx512(p, delimiter, quotes, separators); break;
+    case STRING_VIEW_SIMD_AVX2: string_view__csv_masks_avx2(p, delimiter, quotes, separators); break;
+    case STRING_VIEW_SIMD_SSE2: string_view__csv_masks_sse2(p, delimiter, quotes, separators); break;
+#endif
+    default: string_view__csv_masks_scalar(p, delimiter, quotes, separators); break;
+    }
+}
+
+/* Sets every bit at or above each set bit of `x` an odd number of times: the bytes between an opening and a closing quote. */
+static inline uint64_t string_view__prefix_xor(uint64_t x){
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/* Classifies the next block, keeping only the separators outside quotes. */
+static void string_view__csv_classify(string_view_csv_reader_t* reader){
+    const char* block = &reader->input.data[reader->block];
+    const size_t remaining = reader->input.count - reader->block;
+    uint64_t valid = ~0ULL, quotes, separators;
+    char tail[64];
+
+    if(remaining < 64){
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, block, remaining);
+        block = tail;
+        valid = (1ULL << remaining) - 1;
+    }
+
+    string_view__csv_masks(block, reader->delimiter, &quotes, &separators);
+
+    const uint64_t inside = string_view__prefix_xor(quotes & valid) ^ reader->quoted;
+    reader->quoted = 0ULL - (inside >> 63);
+    reader->separators = separators & valid & ~inside;
+}
+
+static string_view_t string_view__csv_field(string_view_csv_reader_t* reader, size_t start, size_t end, bool last){
+    const char* p = reader->input.data;
+
+    if(last && end > start && p[end - 1] == '\r') end--;
+    if(end == start || p[start] != '"') return new_string_view(&p[start], end - start);
+
+    start++;
+    if(end > start && p[end - 1] == '"') end--;
+
+    const char* escape = (end > start) ? memchr(&p[start], '"', end - start) : NULL;
+    if(escape == NULL || reader->arena == NULL) return new_string_view(&p[start], end - start);
+
+    char* copy = string_view_arena_alloc(reader->arena, end - start);
+    if(copy == NULL) return new_string_view(&p[start], end - start);
+
+    size_t length = (size_t)(escape - &p[start]);
+    memcpy(copy, &p[start], length);
+
+    for(size_t i = (size_t)(escape - p); i < end; i++){
+        copy[length++] = p[i];
+        if(p[i] == '"' && i + 1 < end && p[i + 1] == '"') i++;
+    }
+
+    return new_string_view(copy, length);
+}
+
+inline string_view_csv_reader_t new_string_view_csv_reader(string_view_t input, char delimiter, string_view_arena_t* arena){
+    return (string_view_csv_reader_t) {
+        .input = input,
+        .arena = arena,
+        .cursor = 0,
+        .block = 0,
+        .separators = 0,
+        .quoted = 0,
+        .delimiter = delimiter
+    };
+}
+
+bool string_view_csv_next_row(string_view_csv_reader_t* reader, string_view_t* fields, size_t capacity, size_t* count){
+    const size_t n = reader->input.count;
+    size_t total = 0;
+
+    if(reader->cursor >= n) return false;
+
+    for(;;){
+        while(reader->separators == 0){
+            if(reader->block >= n){
+                if(total < capacity) fields[total] = string_view__csv_field(reader, reader->cursor, n, true);
+                reader->cursor = n + 1;
+                *count = total + 1;
+                return true;
+            }
+
+            string_view__csv_classify(reader);
+            reader->block += 64;
+        }
+
+        const size_t pos = reader->block - 64 + (size_t)string_view__ctz64(reader->separators);
+        const bool last = reader->input.data[pos] == '\n';
+
+        reader->separators &= reader->separators - 1;
+        if(total < capacity) fields[total] = string_view__csv_field(reader, reader->cursor, pos, last);
+        total++;
+        reader->cursor = pos + 1;
+
+        if(last){
+            *count = total;
+            return true;
+        }
+    }
+}
+
+/* The `tchar` bytes of RFC 7230, which make up methods and header names. */
+static const string_view_charset_t string_view__http_token = {
+    { 0x03FF6CFA00000000ULL, 0x57FFFFFFC7FFFFFEULL, 0, 0 },
+    { 0xE8, 0xFC, 0xF8, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xF8, 0xF8, 0xF4, 0x54, 0xD0, 0x54, 0xF4, 0x70 },
+    { 0 },
+    { 0 },
+    0
+};
+
+/* Control characters, space and DEL, which end a request target. */
+static const string_view_charset_t string_view__http_path_end = {
+    { 0x00000001FFFFFFFFULL, 0x8000000000000000ULL, 0, 0 },
+    { 0x07, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x83 },
+    { 0 },
+    { 0 },
+    0
+};
+
+/* Control characters but the tab, and DEL, which end a header value. */
+static const string_view_charset_t string_view__http_value_end = {
+    { 0x00000000FFFFFDFFULL, 0x8000000000000000ULL, 0, 0 },
+    { 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x02, 0x03, 0x03, 0x03, 0x03, 0x03, 0x83 },
+    { 0 },
+    { 0 },
+    0
+};
+
+/* Checks for the empty line ending the head, looking only at the newlines that may be new since `last_len`. */
+static bool string_view__http_complete(const char* p, size_t n, size_t last_len){
+    size_t i = (last_len < 3) ? 0 : last_len - 3;
+
+    while(i < n){
+        const size_t pos = string_view__find_char(&p[i], n - i, '\n');
+        if(pos == STRING_VIEW_NPOS) return false;
+
+        i += pos + 1;
+        if(i < n && p[i] == '\n') return true;
+        if(i + 1 < n && p[i] == '\r' && p[i + 1] == '\n') return true;
+    }
+
+    return false;
+}
+
+/* Consumes the `\r\n` or `\n` at `*i`. */
+static int string_view__http_eol(const char* p, size_t n, size_t* i){
+    if(*i >= n) return STRING_VIEW_HTTP_INCOMPLETE;
+
+    if(p[*i] == '\r'){
+        if(*i + 1 >= n) return STRING_VIEW_HTTP_INCOMPLETE;
+        if(p[*i + 1] != '\n') return STRING_VIEW_HTTP_ERROR;
+        *i += 2;
+        return 0;
+    }
+
+    if(p[*i] != '\n') return STRING_VIEW_HTTP_ERROR;
+    *i += 1;
+    return 0;
+}
+
+/* Scans a run of `set` members (or non-members) from `*i` that must be non-empty and end with `terminator`. */
+static int string_view__http_scan(string_view_t buffer, size_t* i, const string_view_charset_t* set, bool member,
+                                  char terminator, string_view_t* out){
+    const size_t end = member
+        ? string_view_find_first_not_of(buffer, set, *i)
+        : string_view_find_first_of(buffer, set, *i);
+
+    if(end == STRING_VIEW_NPOS) return STRING_VIEW_HTTP_INCOMPLETE;
+    if(end == *i || buffer.data[end] != terminator) return STRING_VIEW_HTTP_ERROR;
+
+    *out = new_string_view(&buffer.data[*i], end - *i);
+    *i = end + 1;
+    return 0;
+}
+
+int string_view_http_parse_request(string_view_t buffer, size_t last_len, string_view_http_request_t* request,
+                                   string_view_http_header_t* headers, size_t* header_count){
+    static const char version[] = "HTTP/1.";
+    const char* p = buffer.data;
+    const size_t n = buffer.count;
+    const size_t capacity = *header_count;
+    size_t i = 0, count = 0;
+    int status;
+
+    *header_count = 0;
+    if(last_len != 0 && !string_view__http_complete(p, n, last_len)) return STRING_VIEW_HTTP_INCOMPLETE;
+
+    /* Empty lines before the request line are ignored, as RFC 7230 recommends. */
+    while(i < n && (p[i] == '\r' || p[i] == '\n')) i++;
+
+    if((status = string_view__http_scan(buffer, &i, &string_view__http_token, true, ' ', &request->method)) != 0) return status;
+    if((status = string_view__http_scan(buffer, &i, &string_view__http_path_end, false, ' ', &request->path)) != 0) return status;
+
+    for(size_t k = 0; k < 7; k++){
+        if(i + k >= n) return STRING_VIEW_HTTP_INCOMPLETE;
+        if(p[i + k] != version[k]) return STRING_VIEW_HTTP_ERROR;
+    }
+    if(i + 7 >= n) return STRING_VIEW_HTTP_INCOMPLETE;
+    if(p[i + 7] < '0' || p[i + 7] > '9') return STRING_VIEW_HTTP_ERROR;
+    request->minor_version = p[i + 7] - '0';
+    i += 8;
+
+    if((status = string_view__http_eol(p, n, &i)) != 0) return status;
+
+    for(;;){
+        if(i >= n) return STRING_VIEW_HTTP_INCOMPLETE;
+        if(p[i] == '\r' || p[i] == '\n') break;
+        if(count == capacity) return STRING_VIEW_HTTP_ERROR;
+
+        string_view_http_header_t* header = &headers[count];
+        if((status = string_view__http_scan(buffer, &i, &string_view__http_token, true, ':', &header->name)) != 0) return status;
+
+        while(i < n && (p[i] == ' ' || p[i] == '\t')) i++;
+
+        size_t end = string_view_find_first_of(buffer, &string_view__http_value_end, i);
+        if(end == STRING_VIEW_NPOS) return STRING_VIEW_HTTP_INCOMPLETE;
+
+        const size_t eol = end;
+        while(end > i && (p[end - 1] == ' ' || p[end - 1] == '\t')) end--;
+        header->value = new_string_view(&p[i], end - i);
+        i = eol;
+
+        if((status = string_view__http_eol(p, n, &i)) != 0) return status;
+        count++;
+    }
+
+    if((status = string_view__http_eol(p, n, &i)) != 0) return status;
+
+    *header_count = count;
+    return (int)i;
+}
+
+const string_view_http_header_t* string_view_http_find_header(const string_view_http_header_t* headers, size_t count,
+                                                              string_view_t name){
+    for(size_t i = 0; i < count; i++){
+        if(string_view_iequal(headers[i].name, name)){
+            return &headers[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Sets bit 5 of the ASCII capital letters of a word, leaving every other byte unchanged. */
+static inline uint64_t string_view__ascii_lower8(uint64_t word){
+    const uint64_t heptets = word & 0x7f7f7f7f7f7f7f7fULL;
+    const uint64_t above_z = heptets + 0x2525252525252525ULL;
+    const uint64_t from_a = heptets + 0x3f3f3f3f3f3f3f3fULL;
+    const uint64_t upper = (from_a ^ above_z) & ~word & 0x8080808080808080ULL;
+
+    return word | (upper >> 2);
+}
+
+/* Each `*_imismatch` kernel returns the first index where the folded bytes of `a` and `b` differ, or `n`. */
+static size_t string_view__imismatch_scalar(const char* a, const char* b, size_t n){
+    size_t i = 0;
+
+    for(; i + 8 <= n; i += 8){
+        uint64_t x, y;
+        memcpy(&x, &a[i], 8);
+        memcpy(&y, &b[i], 8);
+        if(string_view__ascii_lower8(x) != string_view__ascii_lower8(y)) break;
+    }
+
+    for(; i < n; i++){
+        if(string_view__ascii_lower(a[i]) != string_view__ascii_lower(b[i])) return i;
+    }
+
+    return n;
+}
+
+#ifdef STRING_VIEW__X86
+
+/* Capital letters land on the 26 lowest signed values once shifted by 0x80 - 'A'. */
+STRING_VIEW__TARGET_SSE2
+static inline __m128i string_view__fold_sse2(__m128i x){
+    const __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8((char)(0x80 - 'A')));
+    const __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+    return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+STRING_VIEW__TARGET_AVX2
+static inline __m256i string_view__fold_avx2(__m256i x){
+    const __m256i shifted = _mm256_add_epi8(x, _mm256_set1_epi8((char)(0x80 - 'A')));
+    const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+    return _mm256_or_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+STRING_VIEW__TARGET_AVX512
+static inline __m512i string_view__fold_avx512(__m512i x){
+    const __mmask64 upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(x, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+    return _mm512_mask_add_epi8(x, upper, x, _mm512_set1_epi8(0x20));
+}
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__imismatch_sse2(const char* a, const char* b, size_t n){
+    size_t i = 0;
+
+    for(; i + 16 <= n; i += 16){
+        const __m128i x = string_view__fold_sse2(_mm_loadu_si128((const __m128i*)(a + i)));
+        const __m128i y = string_view__fold_sse2(_mm_loadu_si128((const __m128i*)(b + i)));
+        const unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffffu;
+
+        if(mask != 0) return i + (size_t)__builtin_ctz(mask);
+    }
+
+    return i + string_view__imismatch_scalar(a + i, b + i, n - i);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__imismatch_avx2(const char* a, const char* b, size_t n){
+    size_t i = 0;
+
+    for(; i + 32 <= n; i += 32){
+        const __m256i x = string_view__fold_avx2(_mm256_loadu_si256((const __m256i*)(a + i)));
+        const __m256i y = string_view__fold_avx2(_mm256_loadu_si256((const __m256i*)(b + i)));
+        const uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+
+        if(mask != 0) return i + (size_t)_tzcnt_u32(mask);
+    }
+
+    return i + string_view__imismatch_sse2(a + i, b + i, n - i);
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__imismatch_avx512(const char* a, const char* b, size_t n){
+    size_t i = 0;
+
+    while(i < n){
+        const __mmask64 valid = (n - i >= 64) ? ~0ULL : string_view__tail_mask64(n - i);
+        const __m512i x = string_view__fold_avx512(_mm512_maskz_loadu_epi8(valid, a + i));
+        const __m512i y = string_view__fold_avx512(_mm512_maskz_loadu_epi8(valid, b + i));
+        const uint64_t mask = _mm512_cmpneq_epi8_mask(x, y);
+
+        if(mask != 0) return i + (size_t)_tzcnt_u64(mask);
+        i += 64;
+    }
+
+    return n;
+}
+
+#endif
+
+static size_t string_view__imismatch(const char* a, const char* b, size_t n){
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__imismatch_avx512(a, b, n);
+    case STRING_VIEW_SIMD_AVX2: return string_view__imismatch_avx2(a, b, n);
+    case STRING_VIEW_SIMD_SSE2: return string_view__imismatch_sse2(a, b, n);
+#endif
+    default: return string_view__imismatch_scalar(a, b, n);
+    }
+}
+
+/* Each `*_ifilter` kernel returns the first position from `i` where the needle matches ignoring case, or `STRING_VIEW_NPOS`. */
+static size_t string_view__ifilter_scalar(const char* hay, size_t n, const char* needle, size_t m, size_t i){
+    const unsigned char first = string_view__ascii_lower(needle[0]);
+    const unsigned char last = string_view__ascii_lower(needle[m - 1]);
+
+    for(; i + m <= n; i++){
+        if(string_view__ascii_lower(hay[i]) == first && string_view__ascii_lower(hay[i + m - 1]) == last
+           && (m <= 2 || string_view__imismatch_scalar(&hay[i + 1], &needle[1], m - 2) == m - 2)) return i;
+    }
+
+    return STRING_VIEW_NPOS;
+}
+
+#ifdef STRING_VIEW__X86
+
+STRING_VIEW__TARGET_SSE2
+static size_t string_view__ifilter_sse2(const char* hay, size_t n, const char* needle, size_t m, size_t i){
+    const __m128i first = _mm_set1_epi8((char)string_view__ascii_lower(needle[0]));
+    const __m128i last = _mm_set1_epi8((char)string_view__ascii_lower(needle[m - 1]));
+
+    for(; i + m + 15 <= n; i += 16){
+        const __m128i eq_first = _mm_cmpeq_epi8(string_view__fold_sse2(_mm_loadu_si128((const __m128i*)&hay[i])), first);
+        const __m128i eq_last = _mm_cmpeq_epi8(string_view__fold_sse2(_mm_loadu_si128((const __m128i*)&hay[i + m - 1])), last);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)__builtin_ctz(mask);
+            if(m <= 2 || string_view__imismatch_sse2(&hay[pos + 1], &needle[1], m - 2) == m - 2) return pos;
+            mask &= mask - 1;
+        }
+    }
+
+    return string_view__ifilter_scalar(hay, n, needle, m, i);
+}
+
+STRING_VIEW__TARGET_AVX2
+static size_t string_view__ifilter_avx2(const char* hay, size_t n, const char* needle, size_t m, size_t i){
+    const __m256i first = _mm256_set1_epi8((char)string_view__ascii_lower(needle[0]));
+    const __m256i last = _mm256_set1_epi8((char)string_view__ascii_lower(needle[m - 1]));
+
+    for(; i + m + 31 <= n; i += 32){
+        const __m256i eq_first = _mm256_cmpeq_epi8(string_view__fold_avx2(_mm256_loadu_si256((const __m256i*)&hay[i])), first);
+        const __m256i eq_last = _mm256_cmpeq_epi8(string_view__fold_avx2(_mm256_loadu_si256((const __m256i*)&hay[i + m - 1])), last);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last));
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)_tzcnt_u32(mask);
+            if(m <= 2 || string_view__imismatch_avx2(&hay[pos + 1], &needle[1], m - 2) == m - 2) return pos;
+            mask = _blsr_u32(mask);
+        }
+    }
+
+    return string_view__ifilter_sse2(hay, n, needle, m, i);
+}
+
+STRING_VIEW__TARGET_AVX512
+static size_t string_view__ifilter_avx512(const char* hay, size_t n, const char* needle, size_t m, size_t i){
+    const __m512i first = _mm512_set1_epi8((char)string_view__ascii_lower(needle[0]));
+    const __m512i last = _mm512_set1_epi8((char)string_view__ascii_lower(needle[m - 1]));
+
+    for(; i + m + 63 <= n; i += 64){
+        const __mmask64 eq_first = _mm512_cmpeq_epi8_mask(string_view__fold_avx512(_mm512_loadu_si512((const void*)&hay[i])), first);
+        uint64_t mask = _mm512_mask_cmpeq_epi8_mask(eq_first, string_view__fold_avx512(_mm512_loadu_si512((const void*)&hay[i + m - 1])), last);
+
+        while(mask != 0){
+            const size_t pos = i + (size_t)_tzcnt_u64(mask);
+            if(m <= 2 || string_view__imismatch_avx512(&hay[pos + 1], &needle[1], m - 2) == m - 2) return pos;
+            mask = _blsr_u64(mask);
+        }
+    }
+
+    return string_view__ifilter_avx2(hay, n, needle, m, i);
+}
+
+#endif
+
+bool string_view_iequal(string_view_t sv1, string_view_t sv2){
+    return sv1.count == sv2.count && string_view__imismatch(sv1.data, sv2.data, sv1.count) == sv1.count;
+}
+
+int string_view_icompare(string_view_t sv1, string_view_t sv2){
+    const size_t count = (sv1.count < sv2.count) ? sv1.count : sv2.count;
+    const size_t pos = string_view__imismatch(sv1.data, sv2.data, count);
+
+    if(pos < count) return (int)string_view__ascii_lower(sv1.data[pos]) - (int)string_view__ascii_lower(sv2.data[pos]);
+    return (sv1.count > sv2.count) - (sv1.count < sv2.count);
+}
+
+bool string_view_istarts_with(string_view_t sv, string_view_t prefix){
+    if(prefix.count > sv.count) return false;
+    return string_view__imismatch(sv.data, prefix.data, prefix.count) == prefix.count;
+}
+
+bool string_view_iends_with(string_view_t sv, string_view_t suffix){
+    if(suffix.count > sv.count) return false;
+    return string_view__imismatch(&sv.data[sv.count - suffix.count], suffix.data, suffix.count) == suffix.count;
+}
+
+size_t string_view_ifind(string_view_t haystack, string_view_t needle, size_t start){
+    const size_t m = needle.count;
+
+    if(start > haystack.count || m > haystack.count - start) return STRING_VIEW_NPOS;
+    if(m == 0) return start;
+
+    if(m > STRING_VIEW__FILTER_MAX){
+        string_view_searcher_t searcher;
+        size_t position = STRING_VIEW_NPOS;
+        string_view__matches_t matches = { &position, 1, 0, 1 };
+
+        string_view__two_way_init(&searcher, needle, true);
+        string_view__two_way(&searcher, (const unsigned char*)haystack.data, haystack.count, start, true, &matches);
+        return position;
+    }
+
+    switch(string_view__simd()){
+#ifdef STRING_VIEW__X86
+    case STRING_VIEW_SIMD_AVX512: return string_view__ifilter_avx512(haystack.data, haystack.count, needle.data, m, start);
+    case STRING_VIEW_SIMD_AVX2: return string_view__ifilter_avx2(haystack.data, haystack.count, needle.data, m, start);
+    case STRING_VIEW_SIMD_SSE2: return string_view__ifilter_sse2(haystack.data, haystack.count, needle.data, m, start);
+#endif
+    default: return string_view__ifilter_scalar(haystack.data, haystack.count, needle.data, m, start);
+    }
+}
+
+#define STRING_VIEW__MPH_BUCKET_SIZE 5
+#define STRING_VIEW__MPH_ATTEMPTS 64
+#define STRING_VIEW__MPH_EMPTY UINT32_MAX
+
+/* Derives the bucket from the high half of the hash and the slot from the bucket displacements. */
+static inline size_t string_view__mph_slot(uint64_t h, const uint32_t* displacements, size_t bucket_count, size_t count){
+    const uint32_t* d = &displacements[2 * ((uint32_t)(h >> 32) % bucket_count)];
+    const uint32_t f1 = (uint32_t)h;
+    const uint32_t f2 = (uint32_t)((h * 0x9e3779b97f4a7c15ULL) >> 32);
+
+    return (uint32_t)(d[0] * f1 + f2 + d[1]) % count;
+}
+
+typedef struct {
+    uint64_t* hashes;
+    uint32_t* members;
+    uint32_t* offsets;
+    uint32_t* order;
+    uint32_t* stamps;
+    bool duplicate;
+} string_view__mph_scratch_t;
+
+/* Places every bucket for the current seed; fails if a bucket cannot be placed or two keys collide completely. */
+static bool string_view__mph_place(string_view_mph_t* mph, string_view__mph_scratch_t* scratch){
+    const size_t n = mph->count, buckets = mph->bucket_count;
+    uint32_t stamp = 0;
+
+    memset(scratch->offsets, 0, (buckets + 1) * sizeof(uint32_t));
+    for(size_t i = 0; i < n; i++){
+        scratch->hashes[i] = string_view_hash(mph->keys[i], mph->seed);
+        scratch->offsets[(uint32_t)(scratch->hashes[i] >> 32) % buckets + 1]++;
+    }
+    for(size_t b = 0; b < buckets; b++) scratch->offsets[b + 1] += scratch->offsets[b];
+
+    /* Members grouped by bucket, then buckets ordered by decreasing size with a counting sort. */
+    memset(scratch->stamps, 0, n * sizeof(uint32_t));
+    for(size_t i = 0; i < n; i++){
+        const size_t b = (uint32_t)(scratch->hashes[i] >> 32) % buckets;
+        scratch->members[scratch->offsets[b] + scratch->stamps[b]++] = (uint32_t)i;
+    }
+
+    size_t largest = 0;
+    memset(scratch->stamps, 0, (n + 1) * sizeof(uint32_t));
+    for(size_t b = 0; b < buckets; b++){
+        const size_t size = scratch->offsets[b + 1] - scratch->offsets[b];
+        scratch->stamps[size]++;
+        if(size > largest) largest = size;
+    }
+    for(size_t size = largest, position = 0; size + 1 > 0; size--){
+        const uint32_t total = scratch->stamps[size];
+        scratch->stamps[size] = (uint32_t)position;
+        position += total;
+    }
+    for(size_t b = 0; b < buckets; b++){
+        scratch->order[scratch->stamps[scratch->offsets[b + 1] - scratch->offsets[b]]++] = (uint32_t)b;
+    }
+
+    memset(scratch->stamps, 0, n * sizeof(uint32_t));
+    for(size_t i = 0; i < n; i++) mph->slots[i] = STRING_VIEW__MPH_EMPTY;
+    memset(mph->displacements, 0, 2 * buckets * sizeof(uint32_t));
+
+    for(size_t k = 0; k < buckets; k++){
+        const size_t b = scratch->order[k];
+        const uint32_t* members = &scratch->members[scratch->offsets[b]];
+        const size_t size = scratch->offsets[b + 1] - scratch->offsets[b];
+        bool placed = false;
+
+        if(size == 0) break;
+
+        for(size_t i = 0; i < size; i++){
+            for(size_t j = i + 1; j < size; j++){
+                if(scratch->hashes[members[i]] != scratch->hashes[members[j]]) continue;
+                scratch->duplicate = string_view_equal(mph->keys[members[i]], mph->keys[members[j]]);
+                return false;
+            }
+        }
+
+        for(uint32_t d0 = 0; d0 < n && !placed; d0++){
+            for(uint32_t d1 = 0; d1 < n && !placed; d1++){
+                size_t i = 0;
+
+                mph->displacements[2 * b] = d0;
+                mph->displacements[2 * b + 1] = d1;
+                stamp++;
+
+                for(; i < size; i++){
+                    const size_t slot = string_view__mph_slot(scratch->hashes[members[i]], mph->displacements, buckets, n);
+                    if(mph->slots[slot] != STRING_VIEW__MPH_EMPTY || scratch->stamps[slot] == stamp) break;
+                    scratch->stamps[slot] = stamp;
+                }
+
+                placed = i == size;
+            }
+        }
+
+        if(!placed) return false;
+
+        for(size_t i = 0; i < size; i++){
+            const size_t slot = string_view__mph_slot(scratch->hashes[members[i]], mph->displacements, buckets, n);
+            mph->slots[slot] = members[i];
+        }
+    }
+
+    return true;
+}
+
+bool string_view_mph_build(string_view_mph_t* mph, const string_view_t* keys, size_t count){
+    string_view__mph_scratch_t scratch;
+    bool built = false;
+
+    memset(mph, 0, sizeof(*mph));
+    mph->keys = keys;
+    mph->count = count;
+    if(count == 0) return true;
+    if(count >= STRING_VIEW__MPH_EMPTY) return false;
+
+    mph->bucket_count = (count + STRING_VIEW__MPH_BUCKET_SIZE - 1) / STRING_VIEW__MPH_BUCKET_SIZE;
+    mph->displacements = STRING_VIEW_MALLOC(2 * mph->bucket_count * sizeof(uint32_t));
+    mph->slots = STRING_VIEW_MALLOC(count * sizeof(uint32_t));
+
+    scratch.hashes = STRING_VIEW_MALLOC(count * sizeof(uint64_t));
+    scratch.members = STRING_VIEW_MALLOC(count * sizeof(uint32_t));
+    scratch.offsets = STRING_VIEW_MALLOC((mph->bucket_count + 1) * sizeof(uint32_t));
+    scratch.order = STRING_VIEW_MALLOC(mph->bucket_count * sizeof(uint32_t));
+    scratch.stamps = STRING_VIEW_MALLOC((count + 1) * sizeof(uint32_t));
+    scratch.duplicate = false;
+
+    if(mph->displacements != NULL && mph->slots != NULL && scratch.hashes != NULL && scratch.members != NULL
+       && scratch.offsets != NULL && scratch.order != NULL && scratch.stamps != NULL){
+        for(size_t attempt = 0; attempt < STRING_VIEW__MPH_ATTEMPTS && !built && !scratch.duplicate; attempt++){
+            mph->seed = 0x9e3779b97f4a7c15ULL * (attempt + 1);
+            built = string_view__mph_place(mph, &scratch);
+        }
+    }
+
+    STRING_VIEW_FREE(scratch.hashes);
+    STRING_VIEW_FREE(scratch.members);
+    STRING_VIEW_FREE(scratch.offsets);
+    STRING_VIEW_FREE(scratch.order);
+    STRING_VIEW_FREE(scratch.stamps);
+
+    if(!built) string_view_mph_free(mph);
+    return built;
+}
+
+void string_view_mph_free(string_view_mph_t* mph){
+    STRING_VIEW_FREE(mph->displacements);
+    STRING_VIEW_FREE(mph->slots);
+    memset(mph, 0, sizeof(*mph));
+}
+
+size_t string_view_mph_lookup(const string_view_mph_t* mph, string_view_t key){
+    if(mph->count == 0) return STRING_VIEW_NPOS;
+
+    const uint64_t h = string_view_hash(key, mph->seed);
+    const uint32_t index = mph->slots[string_view__mph_slot(h, mph->displacements, mph->bucket_count, mph->count)];
+
+    return string_view_equal(key, mph->keys[index]) ? index : STRING_VIEW_NPOS;
+}
+
+static void string_view__mph_write_table(FILE* out, const char* name, const char* table, const uint32_t* values, size_t count){
+    fprintf(out, "static const uint32_t %s_%s[%zu] = {", name, table, count);
+    for(size_t i = 0; i < count; i++){
+        fprintf(out, "%s%s%lu", (i > 0) ? "," : "", (i % 12 == 0) ? "\n    " : " ", (unsigned long)values[i]);
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+bool string_view_mph_write_header(const string_view_mph_t* mph, FILE* out, const char* name){
+    fprintf(out, "/* Generated by string_view_mph_write_header, do not edit. */\n\n");
+
+    if(mph->count == 0){
+        fprintf(out, "static inline size_t %s_lookup(string_view_t key){\n", name);
+        fprintf(out, "    (void)key;\n    return STRING_VIEW_NPOS;\n}\n");
+        return ferror(out) == 0;
+    }
+
+    fprintf(out, "static const string_view_t %s_keys[%zu] = {\n", name, mph->count);
+    for(size_t i = 0; i < mph->count; i++){
+        const string_view_t key = mph->keys[i];
+
+        fputs("    { \"", out);
+        for(size_t k = 0; k < key.count; k++){
+            const unsigned char c = (unsigned char)key.data[k];
+            if(c >= 0x20 && c < 0x7f && c != '"' && c != '\\' && c != '?') fputc(c, out);
+            else fprintf(out, "\\%03o", c);
+        }
+        fprintf(out, "\", %zu }%s\n", key.count, (i + 1 < mph->count) ? "," : "");
+    }
+    fprintf(out, "};\n\n");
+
+    string_view__mph_write_table(out, name, "displacements", mph->displacements, 2 * mph->bucket_count);
+    string_view__mph_write_table(out, name, "slots", mph->slots, mph->count);
+
+    fprintf(out, "static inline size_t %s_lookup(string_view_t key){\n", name);
+    fprintf(out, "    const uint64_t h = string_view_hash(key, 0x%016llxULL);\n", (unsigned long long)mph->seed);
+    fprintf(out, "    const uint32_t* d = &%s_displacements[2 * ((uint32_t)(h >> 32) %% %zuu)];\n", name, mph->bucket_count);
+    fprintf(out, "    const uint32_t f1 = (uint32_t)h;\n");
+    fprintf(out, "    const uint32_t f2 = (uint32_t)((h * 0x9e3779b97f4a7c15ULL) >> 32);\n");
+    fprintf(out, "    const uint32_t index = %s_slots[(uint32_t)(d[0] * f1 + f2 + d[1]) %% %zuu];\n", name, mph->count);
+    fprintf(out, "    return string_view_equal(key, %s_keys[index]) ? index : STRING_VIEW_NPOS;\n}\n", name);
+
+    return ferror(out) == 0;
+}
+
+enum {
+    STRING_VIEW__ART_NODE4,
+    STRING_VIEW__ART_NODE16,
+    STRING_VIEW__ART_NODE48,
+    STRING_VIEW__ART_NODE256
+};
+
+typedef struct string_view__art_node {
+    const char* prefix;
+    size_t prefix_count;
+    uint64_t value;
+    uint16_t children;
+    uint8_t kind;
+    bool has_value;
+} string_view__art_node_t;
+
+typedef struct {
+    string_view__art_node_t base;
+    uint8_t keys[4];
+    string_view__art_node_t* child[4];
+} string_view__art_node4_t;
+
+typedef struct {
+    string_view__art_node_t base;
+    uint8_t keys[16];
+    string_view__art_node_t* child[16];
+} string_view__art_node16_t;
+
+/* `index[byte]` is the slot of the child plus one, or 0. */
+typedef struct {
+    string_view__art_node_t base;
+    uint8_t index[256];
+    string_view__art_node_t* child[48];
+} string_view__art_node48_t;
+
+typedef struct {
+    string_view__art_node_t base;
+    string_view__art_node_t* child[256];
+} string_view__art_node256_t;
+
+static const size_t string_view__art_capacity[] = { 4, 16, 48, 256 };
+
+static string_view__art_node_t* string_view__art_new(int kind, const char* prefix, size_t prefix_count){
+    static const size_t sizes[] = {
+        sizeof(string_view__art_node4_t), sizeof(string_view__art_node16_t),
+        sizeof(string_view__art_node48_t), sizeof(string_view__art_node256_t)
+    };
+    string_view__art_node_t* node = STRING_VIEW_CALLOC(1, sizes[kind]);
+
+    if(node != NULL){
+        node->kind = (uint8_t)kind;
+        node->prefix = prefix;
+        node->prefix_count = prefix_count;
+    }
+
+    return node;
+}
+
+static void string_view__art_free_node(string_view__art_node_t* node){
+    if(node == NULL) return;
+
+    switch(node->kind){
+    case STRING_VIEW__ART_NODE4:
+        for(size_t i = 0; i < node->children; i++) string_view__art_free_node(((string_view__art_node4_t*)node)->child[i]);
+        break;
+    case STRING_VIEW__ART_NODE16:
+        for(size_t i = 0; i < node->children; i++) string_view__art_free_node(((string_view__art_node16_t*)node)->child[i]);
+        break;
+    case STRING_VIEW__ART_NODE48:
+        for(size_t i = 0; i < node->children; i++) string_view__art_free_node(((string_view__art_node48_t*)node)->child[i]);
+        break;
+    default:
+        for(size_t i = 0; i < 256; i++) string_view__art_free_node(((string_view__art_node256_t*)node)->child[i]);
+        break;
+    }
+
+    STRING_VIEW_FREE(node);
+}
+
+#ifdef STRING_VIEW__X86
+
+STRING_VIEW__TARGET_SSE2
+static unsigned string_view__art_match16_sse2(const uint8_t* keys, uint8_t byte){
+    const __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)keys), _mm_set1_epi8((char)byte));
+    return (unsigned)_mm_movemask_epi8(eq);
+}
+
+#endif
+
+static int string_view__art_find16(const uint8_t* keys, size_t count, uint8_t byte){
+#ifdef STRING_VIEW__X86
+    if(string_view__simd() >= STRING_VIEW_SIMD_SSE2){
+        const unsigned mask = string_view__art_match16_sse2(keys, byte) & ((1u << count) - 1);
+        return (mask != 0) ? __builtin_ctz(mask) : -1;
+    }
+#endif
+    for(size_t i = 0; i < count; i++){
+        if(keys[i] == byte) return (int)i;
+    }
+    return -1;
+}
+
+/* Returns the address of the child pointer for `byte`, or `NULL`. */
+static string_view__art_node_t** string_view__art_child(string_view__art_node_t* node, uint8_t byte){
+    switch(node->kind){
+    case STRING_VIEW__ART_NODE4: {
+        string_view__art_node4_t* n4 = (string_view__art_node4_t*)node;
+        for(size_t i = 0; i < node->children; i++){
+            if(n4->keys[i] == byte) return &n4->child[i];
+        }
+        return NULL;
+    }
+    case STRING_VIEW__ART_NODE16: {
+        string_view__art_node16_t* n16 = (string_view__art_node16_t*)node;
+        const int i = string_view__art_find16(n16->keys, node->children, byte);
+        return (i >= 0) ? &n16->child[i] : NULL;
+    }
+    case STRING_VIEW__ART_NODE48: {
+        string_view__art_node48_t* n48 = (string_view__art_node48_t*)node;
+        return (n48->index[byte] != 0) ? &n48->child[n48->index[byte] - 1] : NULL;
+    }
+    default: {
+        string_view__art_node256_t* n256 = (string_view__art_node256_t*)node;
+        return (n256->child[byte] != NULL) ? &n256->child[byte] : NULL;
+    }
+    }
+}
+
+/* Returns the child at rank `i` in byte order, storing its edge byte. */
+static string_view__art_node_t* string_view__art_child_at(const string_view__art_node_t* node, size_t* cursor, uint8_t* byte){
+    switch(node->kind){
+    case STRING_VIEW__ART_NODE4:
+    case STRING_VIEW__ART_NODE16: {
+        const uint8_t* keys = (node->kind == STRING_VIEW__ART_NODE4)
+            ? ((const string_view__art_node4_t*)node)->keys : ((const string_view__art_node16_t*)node)->keys;
+        string_view__art_node_t* const* child = (node->kind == STRING_VIEW__ART_NODE4)
+            ? ((const string_view__art_node4_t*)node)->child : ((const string_view__art_node16_t*)node)->child;
+
+        if(*cursor >= node->children) return NULL;
+        *byte = keys[*cursor];
+        return child[(*cursor)++];
+    }
+    case STRING_VIEW__ART_NODE48: {
+        const string_view__art_node48_t* n48 = (const string_view__art_node48_t*)node;
+        for(; *cursor < 256; (*cursor)++){
+            if(n48->index[*cursor] != 0){
+                *byte = (uint8_t)*cursor;
+                return n48->child[n48->index[(*cursor)++] - 1];
+            }
+        }
+        return NULL;
+    }
+    default: {
+        const string_view__art_node256_t* n256 = (const string_view__art_node256_t*)node;
+        for(; *cursor < 256; (*cursor)++){
+            if(n256->child[*cursor] != NULL){
+                *byte = (uint8_t)*cursor;
+                return n256->child[(*cursor)++];
+            }
+        }
+        return NULL;
+    }
+    }
+}
+
+/* Moves the children of a full node into a node of the next size. */
+static string_view__art_node_t* string_view__art_grow(string_view__art_node_t* node){
+    string_view__art_node_t* grown = string_view__art_new(node->kind + 1, node->prefix, node->prefix_count);
+    size_t cursor = 0;
+    uint8_t byte;
+    string_view__art_node_t* child;
+
+    if(grown == NULL) return NULL;
+
+    grown->value = node->value;
+    grown->has_value = node->has_value;
+    grown->children = node->children;
+
+    for(size_t i = 0; (child = string_view__art_child_at(node, &cursor, &byte)) != NULL; i++){
+        switch(grown->kind){
+        case STRING_VIEW__ART_NODE16:
+            ((string_view__art_node16_t*)grown)->keys[i] = byte;
+            ((string_view__art_node16_t*)grown)->child[i] = child;
+            break;
+        case STRING_VIEW__ART_NODE48:
+            ((string_view__art_node48_t*)grown)->index[byte] = (uint8_t)(i + 1);
+            ((string_view__art_node48_t*)grown)->child[i] = child;
+            break;
+        default:
+            ((string_view__art_node256_t*)grown)->child[byte] = child;
+            break;
+        }
+    }
+
+    STRING_VIEW_FREE(node);
+    return grown;
+}
+
+/* Adds a child to the node at `*ref`, growing the node when it is full. */
+static bool string_view__art_add_child(string_view__art_node_t** ref, uint8_t byte, string_view__art_node_t* child){
+    string_view__art_node_t* node = *ref;
+
+    if(node->children == string_view__art_capacity[node->kind]){
+        node = string_view__art_grow(node);
+        if(node == NULL) return false;
+        *ref = node;
+    }
+
+    switch(node->kind){
+    case STRING_VIEW__ART_NODE4:
+    case STRING_VIEW__ART_NODE16: {
+        uint8_t* keys = (node->kind == STRING_VIEW__ART_NODE4)
+            ? ((string_view__art_node4_t*)node)->keys : ((string_view__art_node16_t*)node)->keys;
+        string_view__art_node_t** children = (node->kind == STRING_VIEW__ART_NODE4)
+            ? ((string_view__art_node4_t*)node)->child : ((string_view__art_node16_t*)node)->child;
+        size_t i = node->children;
+
+        for(; i > 0 && keys[i - 1] > byte; i--){
+            keys[i] = keys[i - 1];
+            children[i] = children[i - 1];
+        }
+        keys[i] = byte;
+        children[i] = child;
+        break;
+    }
+    case STRING_VIEW__ART_NODE48: {
+        string_view__art_node48_t* n48 = (string_view__art_node48_t*)node;
+        n48->child[node->children] = child;
+        n48->index[byte] = (uint8_t)(node->children + 1);
+        break;
+    }
+    default:
+        ((string_view__art_node256_t*)node)->child[byte] = child;
+        break;
     }
 
-    return STRING_VIEW_NPOS;
+    node->children++;
+    return true;
 }
 
-size_t string_view_find_substring(string_view_t haystack, string_view_t needle, size_t start){
+static size_t string_view__art_match(const string_view__art_node_t* node, const char* key, size_t count){
+    const size_t limit = (node->prefix_count < count) ? node->prefix_count : count;
+    size_t i = 0;
 
-    if(needle.count > haystack.count) return STRING_VIEW_NPOS;
+    while(i < limit && node->prefix[i] == key[i]) i++;
+    return i;
+}
+
+void string_view_art_init(string_view_art_t* tree){
+    tree->root = NULL;
+    tree->size = 0;
+}
+
+void string_view_art_free(string_view_art_t* tree){
+    string_view__art_free_node(tree->root);
+    string_view_art_init(tree);
+}
+
+bool string_view_art_insert(string_view_art_t* tree, string_view_t key, uint64_t value){
+    string_view__art_node_t** ref = &tree->root;
+    size_t depth = 0;
+
+    for(;;){
+        string_view__art_node_t* node = *ref;
+
+        if(node == NULL){
+            node = string_view__art_new(STRING_VIEW__ART_NODE4, &key.data[depth], key.count - depth);
+            if(node == NULL) return false;
+            node->value = value;
+            node->has_value = true;
+            *ref = node;
+            tree->size++;
+            return true;
+        }
+
+        const size_t matched = string_view__art_match(node, &key.data[depth], key.count - depth);
+
+        if(matched < node->prefix_count){
+            /* The key leaves the compressed path: split it with a node holding the common part. */
+            string_view__art_node_t* split = string_view__art_new(STRING_VIEW__ART_NODE4, node->prefix, matched);
+            string_view__art_node_t* leaf = NULL;
+
+            if(split == NULL) return false;
+            if(depth + matched < key.count){
+                leaf = string_view__art_new(STRING_VIEW__ART_NODE4, &key.data[depth + matched + 1], key.count - depth - matched - 1);
+                if(leaf == NULL){
+                    STRING_VIEW_FREE(split);
+                    return false;
+                }
+                leaf->value = value;
+                leaf->has_value = true;
+            }else{
+                split->value = value;
+                split->has_value = true;
+            }
+
+            const uint8_t edge = (uint8_t)node->prefix[matched];
+            node->prefix += matched + 1;
+            node->prefix_count -= matched + 1;
+            string_view__art_add_child(&split, edge, node);
+            if(leaf != NULL) string_view__art_add_child(&split, (uint8_t)key.data[depth + matched], leaf);
+
+            *ref = split;
+            tree->size++;
+            return true;
+        }
 
-    const size_t count = haystack.count - needle.count;
-    for(size_t i = start; i <= count; i++){
-        if(strncmp(&haystack.data[i], needle.data, needle.count) == 0) return i;
+        depth += matched;
+        if(depth == key.count){
+            tree->size += !node->has_value;
+            node->value = value;
+            node->has_value = true;
+            return true;
+        }
+
+        string_view__art_node_t** child = string_view__art_child(node, (uint8_t)key.data[depth]);
+        if(child == NULL){
+            string_view__art_node_t* leaf = string_view__art_new(STRING_VIEW__ART_NODE4, &key.data[depth + 1], key.count - depth - 1);
+            if(leaf == NULL) return false;
+            leaf->value = value;
+            leaf->has_value = true;
+
+            if(!string_view__art_add_child(ref, (uint8_t)key.data[depth], leaf)){
+                STRING_VIEW_FREE(leaf);
+                return false;
+            }
+            tree->size++;
+            return true;
+        }
+
+        ref = child;
+        depth++;
     }
+}
 
-    return STRING_VIEW_NPOS;
+bool string_view_art_lookup(const string_view_art_t* tree, string_view_t key, uint64_t* value){
+    string_view__art_node_t* node = tree->root;
+    size_t depth = 0;
+
+    while(node != NULL){
+        if(node->prefix_count > key.count - depth
+           || string_view__art_match(node, &key.data[depth], key.count - depth) < node->prefix_count) return false;
+
+        depth += node->prefix_count;
+        if(depth == key.count){
+            if(node->has_value && value != NULL) *value = node->value;
+            return node->has_value;
+        }
+
+        string_view__art_node_t** child = string_view__art_child(node, (uint8_t)key.data[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+
+    return false;
+}
+
+bool string_view_art_longest_prefix(const string_view_art_t* tree, string_view_t sv, size_t* length, uint64_t* value){
+    string_view__art_node_t* node = tree->root;
+    size_t depth = 0;
+    bool found = false;
+
+    while(node != NULL){
+        if(node->prefix_count > sv.count - depth
+           || string_view__art_match(node, &sv.data[depth], sv.count - depth) < node->prefix_count) break;
+
+        depth += node->prefix_count;
+        if(node->has_value){
+            found = true;
+            if(length != NULL) *length = depth;
+            if(value != NULL) *value = node->value;
+        }
+        if(depth == sv.count) break;
+
+        string_view__art_node_t** child = string_view__art_child(node, (uint8_t)sv.data[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+
+    return found;
+}
+
+/* Visits a subtree in order; `path` holds the key bytes leading to the node. Returns `false` to stop. */
+static bool string_view__art_visit(const string_view__art_node_t* node, string_builder_t* path, bool* failed,
+                                   string_view_art_visit_fn visit, void* context){
+    const size_t mark = path->count;
+    string_view__art_node_t* child;
+    size_t cursor = 0;
+    uint8_t byte;
+
+    if(!string_builder_append(path, new_string_view(node->prefix, node->prefix_count))){
+        *failed = true;
+        return false;
+    }
+    if(node->has_value && !visit(context, string_builder_view(path), node->value)) return false;
+
+    while((child = string_view__art_child_at(node, &cursor, &byte)) != NULL){
+        if(!string_builder_append_char(path, (char)byte)){
+            *failed = true;
+            return false;
+        }
+        if(!string_view__art_visit(child, path, failed, visit, context)) return false;
+        path->count = mark + node->prefix_count;
+    }
+
+    path->count = mark;
+    return true;
+}
+
+bool string_view_art_iterate_prefix(const string_view_art_t* tree, string_view_t prefix, string_view_art_visit_fn visit, void* context){
+    string_view__art_node_t* node = tree->root;
+    size_t depth = 0;
+
+    /* Descend to the first node whose subtree holds exactly the keys starting with the prefix. */
+    while(node != NULL && depth < prefix.count){
+        const size_t rest = prefix.count - depth;
+        const size_t matched = string_view__art_match(node, &prefix.data[depth], rest);
+
+        if(matched == rest) break;
+        if(matched < node->prefix_count) return true;
+
+        depth += matched;
+        string_view__art_node_t** child = string_view__art_child(node, (uint8_t)prefix.data[depth]);
+        node = (child != NULL) ? *child : NULL;
+        depth++;
+    }
+
+    if(node == NULL) return true;
+
+    string_builder_t path = new_string_builder();
+    bool failed = false;
+    bool completed = string_builder_append(&path, new_string_view(prefix.data, depth))
+        && string_view__art_visit(node, &path, &failed, visit, context);
+
+    string_builder_free(&path);
+    return completed && !failed;
+}
+
+/* Builds the node for `keys[lo..hi)`, which share their first `depth` bytes. */
+static string_view__art_node_t* string_view__art_build(const string_view_t* keys, const uint64_t* values, size_t lo, size_t hi, size_t depth){
+    const string_view_t first = keys[lo], last = keys[hi - 1];
+    const size_t limit = ((first.count < last.count) ? first.count : last.count) - depth;
+    size_t common = 0, groups = 0;
+
+    while(common < limit && first.data[depth + common] == last.data[depth + common]) common++;
+
+    const size_t split = depth + common;
+    size_t i = lo + (first.count == split);
+
+    for(size_t j = i; j < hi; groups++){
+        const char byte = keys[j].data[split];
+        while(j < hi && keys[j].data[split] == byte) j++;
+    }
+
+    const int kind = (groups <= 4) ? STRING_VIEW__ART_NODE4 : (groups <= 16) ? STRING_VIEW__ART_NODE16
+        : (groups <= 48) ? STRING_VIEW__ART_NODE48 : STRING_VIEW__ART_NODE256;
+    string_view__art_node_t* node = string_view__art_new(kind, &first.data[depth], common);
+
+    if(node == NULL) return NULL;
+    if(first.count == split){
+        node->value = values[lo];
+        node->has_value = true;
+    }
+
+    while(i < hi){
+        const uint8_t byte = (uint8_t)keys[i].data[split];
+        size_t j = i;
+
+        while(j < hi && (uint8_t)keys[j].data[split] == byte) j++;
+
+        string_view__art_node_t* child = string_view__art_build(keys, values, i, j, split + 1);
+        if(child == NULL){
+            string_view__art_free_node(node);
+            return NULL;
+        }
+
+        string_view__art_add_child(&node, byte, child);
+        i = j;
+    }
+
+    return node;
+}
+
+bool string_view_art_bulk_load(string_view_art_t* tree, const string_view_t* keys, const uint64_t* values, size_t count){
+    if(tree->root != NULL) return false;
+    if(count == 0) return true;
+
+    for(size_t i = 1; i < count; i++){
+        if(string_view_compare(keys[i - 1], keys[i]) >= 0) return false;
+    }
+
+    tree->root = string_view__art_build(keys, values, 0, count, 0);
+    if(tree->root == NULL) return false;
+
+    tree->size = count;
+    return true;
+}
+
+#define STRING_VIEW__SAIS_EMPTY UINT32_MAX
+#define STRING_VIEW__SUFFIX_ARRAY_MAGIC 0x3130415358465553ULL /* "SUFXSA01" */
+#define STRING_VIEW__SUFFIX_ARRAY_HEADER 32
+
+typedef struct {
+    const uint32_t* text;
+    uint32_t n;
+    uint32_t upper;
+    uint32_t* sa;
+    const uint8_t* ls;
+    const uint32_t* sum_l;
+    const uint32_t* sum_s;
+    uint32_t* buckets;
+} string_view__sais_t;
+
+/* Induced sorting: places the sorted LMS suffixes, then the L suffixes left to right and the S suffixes right to left. */
+static void string_view__sais_induce(const string_view__sais_t* s, const uint32_t* lms, uint32_t count){
+    const uint32_t n = s->n;
+    uint32_t* sa = s->sa;
+
+    for(uint32_t i = 0; i < n; i++) sa[i] = STRING_VIEW__SAIS_EMPTY;
+
+    memcpy(s->buckets, s->sum_s, (s->upper + 2) * sizeof(uint32_t));
+    for(uint32_t i = 0; i < count; i++){
+        if(lms[i] != n) sa[s->buckets[s->text[lms[i]]]++] = lms[i];
+    }
+
+    memcpy(s->buckets, s->sum_l, (s->upper + 2) * sizeof(uint32_t));
+    sa[s->buckets[s->text[n - 1]]++] = n - 1;
+    for(uint32_t i = 0; i < n; i++){
+        const uint32_t v = sa[i];
+        if(v != STRING_VIEW__SAIS_EMPTY && v >= 1 && !s->ls[v - 1]){
+            sa[s->buckets[s->text[v - 1]]++] = v - 1;
+        }
+    }
+
+    memcpy(s->buckets, s->sum_l, (s->upper + 2) * sizeof(uint32_t));
+    for(uint32_t i = n; i > 0; i--){
+        const uint32_t v = sa[i - 1];
+        if(v != STRING_VIEW__SAIS_EMPTY && v >= 1 && s->ls[v - 1]){
+            sa[--s->buckets[s->text[v - 1] + 1]] = v - 1;
+        }
+    }
+}
+
+/* Sorts the suffixes of a string of `n` symbols in `[0, upper]` into `sa`. */
+static bool string_view__sais(const uint32_t* text, uint32_t n, uint32_t upper, uint32_t* sa){
+    if(n <= 2){
+        if(n == 1) sa[0] = 0;
+        if(n == 2){
+            const bool ascending = text[0] < text[1];
+            sa[0] = ascending ? 0 : 1;
+            sa[1] = ascending ? 1 : 0;
+        }
+        return true;
+    }
+
+    uint8_t* ls = STRING_VIEW_CALLOC(n, 1);
+    uint32_t* sum_l = STRING_VIEW_CALLOC(upper + 2, sizeof(uint32_t));
+    uint32_t* sum_s = STRING_VIEW_CALLOC(upper + 2, sizeof(uint32_t));
+    uint32_t* buckets = STRING_VIEW_MALLOC((upper + 2) * sizeof(uint32_t));
+    uint32_t* lms_map = STRING_VIEW_MALLOC(((size_t)n + 1) * sizeof(uint32_t));
+    uint32_t* lms = STRING_VIEW_MALLOC((n / 2 + 1) * sizeof(uint32_t));
+    uint32_t* sorted = NULL;
+    uint32_t* rec_s = NULL;
+    uint32_t* rec_sa = NULL;
+    bool ok = false;
+
+    if(ls == NULL || sum_l == NULL || sum_s == NULL || buckets == NULL || lms_map == NULL || lms == NULL) goto done;
+
+    for(uint32_t i = n - 1; i > 0; i--){
+        const uint32_t a = text[i - 1], b = text[i];
+        ls[i - 1] = (a == b) ? ls[i] : (a < b);
+    }
+
+    for(uint32_t i = 0; i < n; i++){
+        const uint32_t c = text[i];
+        if(!ls[i]) sum_s[c]++;
+        else sum_l[c + 1]++;
+    }
+    for(uint32_t c = 0; c <= upper; c++){
+        sum_s[c] += sum_l[c];
+        if(c < upper) sum_l[c + 1] += sum_s[c];
+    }
+
+    uint32_t m = 0;
+    for(uint32_t i = 0; i <= n; i++) lms_map[i] = STRING_VIEW__SAIS_EMPTY;
+    for(uint32_t i = 1; i < n; i++){
+        if(!ls[i - 1] && ls[i]){
+            lms_map[i] = m;
+            lms[m++] = i;
+        }
+    }
+
+    const string_view__sais_t state = { text, n, upper, sa, ls, sum_l, sum_s, buckets };
+    string_view__sais_induce(&state, lms, m);
+
+    if(m > 0){
+        sorted = STRING_VIEW_MALLOC(m * sizeof(uint32_t));
+        rec_s = STRING_VIEW_MALLOC(m * sizeof(uint32_t));
+        rec_sa = STRING_VIEW_MALLOC(m * sizeof(uint32_t));
+        if(sorted == NULL || rec_s == NULL || rec_sa == NULL) goto done;
+
+        uint32_t count = 0;
+        for(uint32_t i = 0; i < n; i++){
+            if(lms_map[sa[i]] != STRING_VIEW__SAIS_EMPTY) sorted[count++] = sa[i];
+        }
+
+        /* Names the LMS substrings by rank; equal substrings share a name. */
+        uint32_t rec_upper = 0;
+        rec_s[lms_map[sorted[0]]] = 0;
+        for(uint32_t i = 1; i < m; i++){
+            uint32_t l = sorted[i - 1], r = sorted[i];
+            const uint32_t end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            const uint32_t end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+            bool same = end_l - l == end_r - r;
+
+            if(same){
+                while(l < end_l && text[l] == text[r]){
+                    l++;
+                    r++;
+                }
+                if(l == n || text[l] != text[r]) same = false;
+            }
+
+            if(!same) rec_upper++;
+            rec_s[lms_map[sorted[i]]] = rec_upper;
+        }
+
+        if(!string_view__sais(rec_s, m, rec_upper, rec_sa)) goto done;
+
+        for(uint32_t i = 0; i < m; i++) sorted[i] = lms[rec_sa[i]];
+        string_view__sais_induce(&state, sorted, m);
+    }
+
+    ok = true;
+
+done:
+    STRING_VIEW_FREE(ls);
+    STRING_VIEW_FREE(sum_l);
+    STRING_VIEW_FREE(sum_s);
+    STRING_VIEW_FREE(buckets);
+    STRING_VIEW_FREE(lms_map);
+    STRING_VIEW_FREE(lms);
+    STRING_VIEW_FREE(sorted);
+    STRING_VIEW_FREE(rec_s);
+    STRING_VIEW_FREE(rec_sa);
+    return ok;
+}
+
+bool string_view_suffix_array_build(string_view_suffix_array_t* index, string_view_t text){
+    const size_t n = text.count;
+
+    memset(index, 0, sizeof(*index));
+    index->text = text;
+    if(n == 0) return true;
+    if(n >= STRING_VIEW__SAIS_EMPTY - 1) return false;
+
+    uint32_t* arrays = STRING_VIEW_MALLOC(2 * n * sizeof(uint32_t));
+    uint32_t* scratch = STRING_VIEW_MALLOC(n * sizeof(uint32_t));
+
+    if(arrays == NULL || scratch == NULL){
+        STRING_VIEW_FREE(arrays);
+        STRING_VIEW_FREE(scratch);
+        return false;
+    }
+
+    uint32_t* suffixes = arrays;
+    uint32_t* lcp = arrays + n;
+
+    for(size_t i = 0; i < n; i++) scratch[i] = (unsigned char)text.data[i];
+    if(!string_view__sais(scratch, (uint32_t)n, 255, suffixes)){
+        STRING_VIEW_FREE(arrays);
+        STRING_VIEW_FREE(scratch);
+        return false;
+    }
+
+    /*
+     * Kasai's algorithm in its permuted form: the LCP of each suffix with its predecessor in suffix
+     * order is computed in text order, where it drops by at most one from a position to the next,
+     * then moved to the rank of the suffix.
+     */
+    uint32_t* plcp = scratch;
+    size_t h = 0;
+
+    plcp[suffixes[0]] = STRING_VIEW__SAIS_EMPTY;
+    for(size_t i = 1; i < n; i++) plcp[suffixes[i]] = suffixes[i - 1];
+    for(size_t i = 0; i < n; i++){
+        const size_t j = plcp[i];
+        if(j == STRING_VIEW__SAIS_EMPTY){
+            plcp[i] = 0;
+            h = 0;
+            continue;
+        }
+
+        while(i + h < n && j + h < n && text.data[i + h] == text.data[j + h]) h++;
+        plcp[i] = (uint32_t)h;
+        if(h > 0) h--;
+    }
+    for(size_t i = 0; i < n; i++) lcp[i] = plcp[suffixes[i]];
+
+    STRING_VIEW_FREE(scratch);
+    index->suffixes = suffixes;
+    index->lcp = lcp;
+    index->storage = arrays;
+    index->storage_size = 2 * n * sizeof(uint32_t);
+    return true;
+}
+
+void string_view_suffix_array_free(string_view_suffix_array_t* index){
+#ifdef STRING_VIEW_HAS_MMAP
+    if(index->mapped){
+        string_view_mmap_t map = { STRING_VIEW_EMPTY, index->storage, index->storage_size };
+        string_view_mmap_close(&map);
+    }else
+#endif
+    STRING_VIEW_FREE(index->storage);
+
+    memset(index, 0, sizeof(*index));
+}
+
+bool string_view_suffix_array_save(const string_view_suffix_array_t* index, const char* path){
+    const size_t n = index->text.count;
+    const uint64_t header[4] = { STRING_VIEW__SUFFIX_ARRAY_MAGIC, n, string_view_hash(index->text, 0), 0 };
+    FILE* file = fopen(path, "wb");
+
+    if(file == NULL) return false;
+
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1;
+    if(ok && n > 0){
+        ok = fwrite(index->suffixes, sizeof(uint32_t), n, file) == n
+            && fwrite(index->lcp, sizeof(uint32_t), n, file) == n;
+    }
+
+    return (fclose(file) == 0) && ok;
+}
+
+bool string_view_suffix_array_load(string_view_suffix_array_t* index, const char* path, string_view_t text){
+    const size_t n = text.count;
+    const size_t expected = STRING_VIEW__SUFFIX_ARRAY_HEADER + 2 * n * sizeof(uint32_t);
+    uint64_t header[4];
+    const char* data;
+
+    memset(index, 0, sizeof(*index));
+    if(n >= STRING_VIEW__SAIS_EMPTY - 1) return false;
+
+#ifdef STRING_VIEW_HAS_MMAP
+    string_view_mmap_t map;
+    if(!string_view_mmap_open(&map, path, STRING_VIEW_ADVICE_RANDOM)) return false;
+
+    index->storage = map.address;
+    index->storage_size = map.size;
+    index->mapped = true;
+    data = map.view.data;
+    if(map.size != expected){
+        string_view_suffix_array_free(index);
+        return false;
+    }
+#else
+    FILE* file = fopen(path, "rb");
+    if(file == NULL) return false;
+
+    index->storage = STRING_VIEW_MALLOC(expected);
+    index->storage_size = expected;
+    data = index->storage;
+    if(index->storage == NULL || fread(index->storage, 1, expected, file) != expected || fgetc(file) != EOF){
+        fclose(file);
+        string_view_suffix_array_free(index);
+        return false;
+    }
+    fclose(file);
+#endif
+
+    memcpy(header, data, sizeof(header));
+    if(header[0] != STRING_VIEW__SUFFIX_ARRAY_MAGIC || header[1] != n || header[2] != string_view_hash(text, 0)){
+        string_view_suffix_array_free(index);
+        return false;
+    }
+
+    index->text = text;
+    if(n > 0){
+        index->suffixes = (const uint32_t*)(const void*)(data + STRING_VIEW__SUFFIX_ARRAY_HEADER);
+        index->lcp = index->suffixes + n;
+    }
+    return true;
+}
+
+/*
+ * Returns the first rank whose suffix is not below the pattern (or, for `upper`, above its prefix).
+ * The bytes shared by the pattern and both bounds of the range are skipped, which keeps most
+ * comparisons well below m bytes.
+ */
+static size_t string_view__suffix_array_bound(const string_view_suffix_array_t* index, string_view_t pattern, bool upper){
+    const unsigned char* text = (const unsigned char*)index->text.data;
+    const unsigned char* p = (const unsigned char*)pattern.data;
+    const size_t n = index->text.count, m = pattern.count;
+    size_t lo = 0, hi = n, lo_common = 0, hi_common = 0;
+
+    while(lo < hi){
+        const size_t mid = lo + (hi - lo) / 2;
+        const size_t suffix = index->suffixes[mid];
+        const size_t available = n - suffix;
+        size_t k = (lo_common < hi_common) ? lo_common : hi_common;
+        bool below;
+
+        while(k < m && k < available && text[suffix + k] == p[k]) k++;
+
+        if(k == m) below = upper;
+        else if(k == available) below = true;
+        else below = text[suffix + k] < p[k];
+
+        if(below){
+            lo = mid + 1;
+            lo_common = k;
+        }else{
+            hi = mid;
+            hi_common = k;
+        }
+    }
+
+    return lo;
+}
+
+size_t string_view_suffix_array_count(const string_view_suffix_array_t* index, string_view_t pattern){
+    if(pattern.count == 0) return index->text.count + 1;
+    return string_view__suffix_array_bound(index, pattern, true) - string_view__suffix_array_bound(index, pattern, false);
+}
+
+bool string_view_suffix_array_contains(const string_view_suffix_array_t* index, string_view_t pattern){
+    if(pattern.count == 0) return true;
+
+    const size_t rank = string_view__suffix_array_bound(index, pattern, false);
+    if(rank == index->text.count) return false;
+
+    const size_t suffix = index->suffixes[rank];
+    return index->text.count - suffix >= pattern.count && memcmp(&index->text.data[suffix], pattern.data, pattern.count) == 0;
+}
+
+size_t string_view_suffix_array_locate_all(const string_view_suffix_array_t* index, string_view_t pattern,
+                                           size_t* positions, size_t capacity){
+    if(pattern.count == 0){
+        for(size_t i = 0; i <= index->text.count && i < capacity; i++) positions[i] = i;
+        return index->text.count + 1;
+    }
+
+    const size_t first = string_view__suffix_array_bound(index, pattern, false);
+    const size_t last = string_view__suffix_array_bound(index, pattern, true);
+
+    for(size_t i = first; i < last && i - first < capacity; i++) positions[i - first] = index->suffixes[i];
+    return last - first;
+}
+
+#define STRING_VIEW__MYERS_LOCAL_BLOCKS 8
+#define STRING_VIEW__MYERS_LOCAL_WORDS ((256 + 2) * STRING_VIEW__MYERS_LOCAL_BLOCKS)
+
+/*
+ * State of the bit-parallel edit distance: one column of the DP matrix kept as vertical deltas
+ * (`pv` for +1, `mv` for -1) in 64-row blocks, the match masks of every byte, and the value of the
+ * bottom cell.
+ */
+typedef struct {
+    uint64_t* peq;
+    uint64_t* pv;
+    uint64_t* mv;
+    uint64_t* heap;
+    size_t blocks;
+    uint64_t last;
+    size_t score;
+} string_view__myers_t;
+
+static bool string_view__myers_init(string_view__myers_t* state, uint64_t* local, string_view_t pattern,
+                                    string_view_t text, bool reverse){
+    const unsigned char* p = (const unsigned char*)pattern.data;
+    const size_t m = pattern.count, blocks = (m + 63) / 64;
+    uint64_t* words = local;
+
+    state->heap = NULL;
+    if(blocks > STRING_VIEW__MYERS_LOCAL_BLOCKS){
+        words = state->heap = STRING_VIEW_MALLOC((256 + 2) * blocks * sizeof(uint64_t));
+        if(words == NULL) return false;
+    }
+
+    state->peq = words;
+    state->pv = words + 256 * blocks;
+    state->mv = state->pv + blocks;
+    state->blocks = blocks;
+    state->last = 1ULL << ((m - 1) % 64);
+    state->score = m;
+
+    /* Only the masks of bytes that occur are ever read, so short inputs clear just those. */
+    if(text.count + m < 256){
+        for(size_t i = 0; i < text.count; i++){
+            memset(&state->peq[(unsigned char)text.data[i] * blocks], 0, blocks * sizeof(uint64_t));
+        }
+        for(size_t i = 0; i < m; i++) memset(&state->peq[p[i] * blocks], 0, blocks * sizeof(uint64_t));
+    }else{
+        memset(state->peq, 0, 256 * blocks * sizeof(uint64_t));
+    }
+
+    for(size_t i = 0; i < m; i++){
+        const unsigned char c = reverse ? p[m - 1 - i] : p[i];
+        state->peq[c * blocks + i / 64] |= 1ULL << (i % 64);
+    }
+    for(size_t b = 0; b < blocks; b++){
+        state->pv[b] = ~0ULL;
+        state->mv[b] = 0;
+    }
+    return true;
+}
+
+/*
+ * Advances the column by one text byte. `hin` is the horizontal delta entering the top row: +1 when
+ * the whole text must be matched, 0 when the match may start anywhere.
+ */
+static inline void string_view__myers_step(string_view__myers_t* state, unsigned char c, int hin){
+    const uint64_t* eq_row = &state->peq[c * state->blocks];
+
+    for(size_t b = 0; b < state->blocks; b++){
+        const uint64_t high = (b + 1 == state->blocks) ? state->last : (1ULL << 63);
+        const uint64_t pv = state->pv[b], mv = state->mv[b];
+        uint64_t eq = eq_row[b];
+        const uint64_t xv = eq | mv;
+
+        if(hin < 0) eq |= 1;
+
+        const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        const int hout = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+
+        ph = (ph << 1) | (uint64_t)(hin > 0);
+        mh = (mh << 1) | (uint64_t)(hin < 0);
+        state->pv[b] = mh | ~(xv | ph);
+        state->mv[b] = ph & xv;
+        hin = hout;
+    }
+
+    state->score = (hin > 0) ? state->score + 1 : state->score - (size_t)(hin < 0);
+}
+
+static inline void string_view__myers_release(string_view__myers_t* state){
+    STRING_VIEW_FREE(state->heap);
+}
+
+size_t string_view_edit_distance(string_view_t sv1, string_view_t sv2){
+    return string_view_edit_distance_max(sv1, sv2, STRING_VIEW_NPOS - 1);
 }
 
+size_t string_view_edit_distance_max(string_view_t sv1, string_view_t sv2, size_t max_distance){
+    /* The shorter view is the pattern: it sets the number of blocks. */
+    const string_view_t pattern = (sv1.count <= sv2.count) ? sv1 : sv2;
+    const string_view_t text = (sv1.count <= sv2.count) ? sv2 : sv1;
+    const size_t n = text.count, m = pattern.count;
+    uint64_t local[STRING_VIEW__MYERS_LOCAL_WORDS];
+    string_view__myers_t state;
+
+    if(n - m > max_distance) return max_distance + 1;
+    if(m == 0) return n;
+    if(!string_view__myers_init(&state, local, pattern, text, false)) return STRING_VIEW_NPOS;
+
+    size_t distance = STRING_VIEW_NPOS;
+
+    if(state.blocks == 1){
+        /* The single-word case keeps the whole column in registers. */
+        const uint64_t last = state.last;
+        uint64_t pv = ~0ULL, mv = 0;
+        size_t score = m;
+
+        for(size_t j = 0; j < n; j++){
+            const uint64_t eq = state.peq[(unsigned char)text.data[j]];
+            const uint64_t xv = eq | mv;
+            const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+
+            score += (ph & last) != 0;
+            score -= (mh & last) != 0;
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            /* Each remaining column lowers the bottom cell by at most one. */
+            if(score > max_distance && score - max_distance > n - j - 1) break;
+        }
+        distance = score;
+    }else{
+        for(size_t j = 0; j < n; j++){
+            string_view__myers_step(&state, (unsigned char)text.data[j], 1);
+            if(state.score > max_distance && state.score - max_distance > n - j - 1) break;
+        }
+        distance = state.score;
+    }
+
+    string_view__myers_release(&state);
+    return (distance <= max_distance) ? distance : max_distance + 1;
+}
+
+size_t string_view_fuzzy_find(string_view_t haystack, string_view_t needle, size_t max_distance, size_t start,
+                              string_view_fuzzy_match_t* match){
+    const size_t n = haystack.count, m = needle.count;
+    uint64_t local[STRING_VIEW__MYERS_LOCAL_WORDS];
+    string_view__myers_t state;
+
+    if(start > n) return STRING_VIEW_NPOS;
+    if(m == 0){
+        if(match != NULL) *match = (string_view_fuzzy_match_t){ start, 0, 0 };
+        return start;
+    }
+
+    /* Forward pass: the match may start anywhere, so the top row stays at zero. */
+    if(!string_view__myers_init(&state, local, needle, string_view_substr(haystack, start, STRING_VIEW_NPOS), false)){
+        return STRING_VIEW_NPOS;
+    }
+
+    size_t end = (m <= max_distance) ? start : STRING_VIEW_NPOS;
+    size_t best = m;
+
+    for(size_t j = start; j < n; j++){
+        string_view__myers_step(&state, (unsigned char)haystack.data[j], 0);
+        if(end != STRING_VIEW_NPOS){
+            if(state.score >= best) break;
+            best = state.score;
+            end = j + 1;
+        }else if(state.score <= max_distance){
+            best = state.score;
+            end = j + 1;
+        }
+    }
+    string_view__myers_release(&state);
+
+    if(end == STRING_VIEW_NPOS) return STRING_VIEW_NPOS;
+
+    /* Backward pass with the reversed needle, anchored at the end, to find where the match starts. */
+    const size_t span = (end - start < m + best) ? end - start : m + best;
+    const string_view_t window = new_string_view(&haystack.data[end - span], span);
+    size_t length = 0, distance = m;
+
+    if(!string_view__myers_init(&state, local, needle, window, true)) return STRING_VIEW_NPOS;
+    for(size_t j = 0; j < span; j++){
+        string_view__myers_step(&state, (unsigned char)haystack.data[end - 1 - j], 1);
+        if(state.score < distance){
+            distance = state.score;
+            length = j + 1;
+        }
+    }
+    string_view__myers_release(&state);
+
+    if(match != NULL) *match = (string_view_fuzzy_match_t){ end - length, length, distance };
+    return end - length;
+}
+
+#define STRING_VIEW__AC_OUTPUT_FLAG 0x80000000u
+
+bool string_view_automaton_init(string_view_automaton_t* automaton, const string_view_t* patterns, size_t count){
+    size_t total = 1;
+    size_t class_count = 1;
+
+    memset(automaton, 0, sizeof(*automaton));
+    for(size_t i = 0; i < count; i++){
+        total += patterns[i].count;
+        for(size_t j = 0; j < patterns[i].count; j++){
+            const uint8_t byte = (uint8_t)patterns[i].data[j];
+            if(automaton->classes[byte] == 0) automaton->classes[byte] = (uint16_t)class_count++;
+        }
+    }
+
+    if(total > (STRING_VIEW__AC_OUTPUT_FLAG - 1) / class_count || count > UINT32_MAX) return false;
+
+    uint32_t* trie = STRING_VIEW_CALLOC(total * class_count, sizeof(uint32_t));
+    uint32_t* fail = STRING_VIEW_MALLOC(total * sizeof(uint32_t));
+    uint32_t* queue = STRING_VIEW_MALLOC(total * sizeof(uint32_t));
+    size_t* own = STRING_VIEW_CALLOC(total, sizeof(size_t));
+    size_t* outputs = STRING_VIEW_CALLOC(total + 1, sizeof(size_t));
+    size_t* lengths = STRING_VIEW_MALLOC((count + 1) * sizeof(size_t));
+    uint32_t* terminal = STRING_VIEW_MALLOC((count + 1) * sizeof(uint32_t));
+
+    if(!trie || !fail || !queue || !own || !outputs || !lengths || !terminal) goto failure;
+
+    size_t states = 1;
+    for(size_t i = 0; i < count; i++){
+        uint32_t state = 0;
+        for(size_t j = 0; j < patterns[i].count; j++){
+            uint32_t* next = &trie[state * class_count + automaton->classes[(uint8_t)patterns[i].data[j]]];
+            if(*next == 0) *next = (uint32_t)states++;
+            state = *next;
+        }
+        lengths[i] = patterns[i].count;
+        terminal[i] = state;
+        if(state != 0) own[state]++;
+    }
+
+    /* Breadth-first pass: computes the failure links, turns the trie into a DFA and counts the outputs. */
+    size_t head = 0, tail = 0;
+    fail[0] = 0;
+    queue[tail++] = 0;
+    while(head < tail){
+        const uint32_t state = queue[head++];
+        uint32_t* row = &trie[state * class_count];
+        const uint32_t* fail_row = &trie[fail[state] * class_count];
+
+        outputs[state] = own[state] + (state != 0 ? outputs[fail[state]] : 0);
+        for(size_t c = 0; c < class_count; c++){
+            if(row[c] != 0){
+                fail[row[c]] = (state == 0) ? 0 : fail_row[c];
+                queue[tail++] = row[c];
+            }else{
+                row[c] = (state == 0) ? 0 : fail_row[c];
+            }
+        }
+    }
+
+    /* Turns the output counts into offsets and fills every state list with its own patterns
+       followed by the patterns of its failure state. */
+    size_t output_total = 0;
+    for(size_t s = 0; s < states; s++){
+        const size_t n = outputs[s];
+        outputs[s] = output_total;
+        output_total += n;
+    }
+    outputs[states] = output_total;
+
+    uint32_t* output_patterns = STRING_VIEW_MALLOC((output_total + 1) * sizeof(uint32_t));
+    if(!output_patterns) goto failure;
+
+    for(size_t s = 0; s < states; s++) own[s] = outputs[s];
+    for(size_t i = 0; i < count; i++){
+        if(terminal[i] != 0) output_patterns[own[terminal[i]]++] = (uint32_t)i;
+    }
+    for(size_t q = 1; q < states; q++){
+        const uint32_t s = queue[q];
+        const size_t inherited = outputs[fail[s] + 1] - outputs[fail[s]];
+        memcpy(&output_patterns[own[s]], &output_patterns[outputs[fail[s]]], inherited * sizeof(uint32_t));
+    }
+
+    /* Stores the row offset of the target state and flags the states that report matches. */
+    for(size_t i = 0; i < states * class_count; i++){
+        const uint32_t target = trie[i];
+        trie[i] = (uint32_t)(target * class_count)
+            | ((outputs[target + 1] != outputs[target]) ? STRING_VIEW__AC_OUTPUT_FLAG : 0);
+    }
+
+    automaton->transitions = trie;
+    automaton->outputs = outputs;
+    automaton->output_patterns = output_patterns;
+    automaton->lengths = lengths;
+    automaton->class_count = class_count;
+    automaton->state_count = states;
+    automaton->pattern_count = count;
+
+    STRING_VIEW_FREE(fail);
+    STRING_VIEW_FREE(queue);
+    STRING_VIEW_FREE(own);
+    STRING_VIEW_FREE(terminal);
+    return true;
+
+failure:
+    STRING_VIEW_FREE(trie);
+    STRING_VIEW_FREE(fail);
+    STRING_VIEW_FREE(queue);
+    STRING_VIEW_FREE(own);
+    STRING_VIEW_FREE(outputs);
+    STRING_VIEW_FREE(lengths);
+    STRING_VIEW_FREE(terminal);
+    memset(automaton, 0, sizeof(*automaton));
+    return false;
+}
+
+void string_view_automaton_free(string_view_automaton_t* automaton){
+    STRING_VIEW_FREE(automaton->transitions);
+    STRING_VIEW_FREE(automaton->outputs);
+    STRING_VIEW_FREE(automaton->output_patterns);
+    STRING_VIEW_FREE(automaton->lengths);
+    memset(automaton, 0, sizeof(*automaton));
+}
+
+inline string_view_automaton_stream_t new_string_view_automaton_stream(void){
+    return (string_view_automaton_stream_t) {
+        .state = 0,
+        .offset = 0
+    };
+}
+
+size_t string_view_automaton_feed(const string_view_automaton_t* automaton, string_view_automaton_stream_t* stream,
+                                  string_view_t chunk, string_view_match_t* matches, size_t capacity){
+    const uint32_t* transitions = automaton->transitions;
+    const uint16_t* classes = automaton->classes;
+    const uint8_t* bytes = (const uint8_t*)chunk.data;
+    uint32_t row = stream->state;
+    size_t found = 0;
+
+    if(transitions == NULL) return 0;
+
+    for(size_t i = 0; i < chunk.count; i++){
+        const uint32_t next = transitions[row + classes[bytes[i]]];
+        row = next & ~STRING_VIEW__AC_OUTPUT_FLAG;
+
+        if(next & STRING_VIEW__AC_OUTPUT_FLAG){
+            const size_t state = row / automaton->class_count;
+            const size_t end = stream->offset + i + 1;
+
+            for(size_t o = automaton->outputs[state]; o < automaton->outputs[state + 1]; o++, found++){
+                if(found >= capacity) continue;
+
+                const uint32_t pattern = automaton->output_patterns[o];
+                matches[found].pattern = pattern;
+                matches[found].offset = end - automaton->lengths[pattern];
+            }
+        }
+    }
+
+    stream->state = row;
+    stream->offset += chunk.count;
+    return found;
+}
+
+size_t string_view_automaton_find_all(const string_view_automaton_t* automaton, string_view_t haystack,
+                                      string_view_match_t* matches, size_t capacity){
+    string_view_automaton_stream_t stream = new_string_view_automaton_stream();
+    return string_view_automaton_feed(automaton, &stream, haystack, matches, capacity);
+}
 
 #endif
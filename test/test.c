@@ -1,4 +1,12 @@
+/* mkstemp and fdopen are POSIX; strict ISO C modes only declare them when asked to. */
+#if defined(__STRICT_ANSI__) && !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 700
+#endif
+
+#include <ctype.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #include "test_utils.h"
 
@@ -316,6 +324,1804 @@ TEST_SUITE(string_view_prefix_suffix) {
     }
 }
 
+TEST_SUITE(string_view_simd) {
+
+    TEST_CASE("Find the last occurrence of a character"){
+        string_view_t sv = new_string_view_from_cstr("This is a string");
+        string_view_t empty_sv = STRING_VIEW_EMPTY;
+
+        TEST_ASSERT(string_view_rfind_char(sv, 's', STRING_VIEW_NPOS) == 10, "Expect index equal to 10.");
+        TEST_ASSERT(string_view_rfind_char(sv, 's', 9) == 6, "Expect index equal to 6.");
+        TEST_ASSERT(string_view_rfind_char(sv, 'T', 0) == 0, "Expect index equal to 0.");
+        TEST_ASSERT(string_view_rfind_char(sv, '?', STRING_VIEW_NPOS) == STRING_VIEW_NPOS,
+                    "Expect STRING_VIEW_NPOS.");
+        TEST_ASSERT(string_view_rfind_char(empty_sv, 'a', 0) == STRING_VIEW_NPOS,
+                    "Expect STRING_VIEW_NPOS.");
+    }
+
+    TEST_CASE("Count the occurrences of a character"){
+        string_view_t sv = new_string_view_from_cstr("This is a string");
+
+        TEST_ASSERT(string_view_count_char(sv, 's') == 3, "Expect 3 occurrences.");
+        TEST_ASSERT(string_view_count_char(sv, '?') == 0, "Expect 0 occurrences.");
+        TEST_ASSERT(string_view_count_char(STRING_VIEW_EMPTY, 'a') == 0, "Expect 0 occurrences.");
+    }
+
+    TEST_CASE("Vectorized character search matches the scalar results"){
+        char buffer[300];
+
+        srand(42);
+        for(size_t i = 0; i < sizeof(buffer); i++){
+            buffer[i] = (char)('a' + rand() % 8);
+        }
+
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t offset = 0; offset < 5; offset++){
+                for(size_t size = 0; size + offset <= sizeof(buffer); size += 7){
+                    string_view_t sv = new_string_view(&buffer[offset], size);
+
+                    for(char c = 'a'; c <= 'j'; c++){
+                        size_t first = STRING_VIEW_NPOS, last = STRING_VIEW_NPOS, count = 0;
+                        for(size_t i = 0; i < size; i++){
+                            if(sv.data[i] != c) continue;
+                            if(first == STRING_VIEW_NPOS) first = i;
+                            last = i;
+                            count++;
+                        }
+
+                        TEST_CHECK(string_view_find_char(sv, c, 0) == first,
+                                   "Expect the first '%c' of %zu bytes at offset %zu on level %d.", c, size, offset, level);
+                        TEST_CHECK(string_view_rfind_char(sv, c, STRING_VIEW_NPOS) == last,
+                                   "Expect the last '%c' of %zu bytes at offset %zu on level %d.", c, size, offset, level);
+                        TEST_CHECK(string_view_count_char(sv, c) == count,
+                                   "Expect %zu '%c' in %zu bytes at offset %zu on level %d.", count, c, size, offset, level);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_SUITE(string_view_searcher) {
+
+    TEST_CASE("Select the search algorithm from the needle length"){
+        string_view_searcher_t empty = new_string_view_searcher(STRING_VIEW_EMPTY);
+        string_view_searcher_t single = new_string_view_searcher(new_string_view_from_cstr("a"));
+        string_view_searcher_t small = new_string_view_searcher(new_string_view_from_cstr("needle"));
+        string_view_searcher_t large = new_string_view_searcher(
+            new_string_view_from_cstr("a needle that is definitely longer than thirty-two bytes"));
+
+        TEST_ASSERT(empty.algorithm == STRING_VIEW_SEARCH_EMPTY, "Expect the empty needle algorithm.");
+        TEST_ASSERT(single.algorithm == STRING_VIEW_SEARCH_CHAR, "Expect the character algorithm.");
+        TEST_ASSERT(small.algorithm == STRING_VIEW_SEARCH_FILTER, "Expect the filter algorithm.");
+        TEST_ASSERT(large.algorithm == STRING_VIEW_SEARCH_TWO_WAY, "Expect the Two-Way algorithm.");
+    }
+
+    TEST_CASE("Search substrings with embedded null characters"){
+        string_view_t haystack = new_string_view("ab\0cd\0ab\0ce", 12);
+        string_view_t needle = new_string_view("b\0c", 3);
+        string_view_searcher_t searcher = new_string_view_searcher(needle);
+        size_t positions[4] = {0};
+
+        TEST_ASSERT(string_view_find_substring(haystack, needle, 0) == 1, "Expect index equal to 1.");
+        TEST_ASSERT(string_view_searcher_find(&searcher, haystack, 2) == 7, "Expect index equal to 7.");
+        TEST_ASSERT(string_view_searcher_find_next(&searcher, haystack, 7) == STRING_VIEW_NPOS,
+                    "Expect STRING_VIEW_NPOS.");
+        TEST_ASSERT(string_view_searcher_find_all(&searcher, haystack, positions, 4) == 2,
+                    "Expect 2 occurrences.");
+        TEST_ASSERT(positions[0] == 1 && positions[1] == 7, "Expect the occurrences at 1 and 7.");
+    }
+
+    TEST_CASE("Searchers match the naive search results"){
+        char haystack[600];
+        char needle[80];
+        size_t expected[600];
+        size_t found[600];
+
+        srand(7);
+        FOR_EACH_SIMD_LEVEL(level){
+            for(int round = 0; round < 40; round++){
+                const int alphabet = 2 + round % 3;
+                const size_t m = 1 + (size_t)rand() % sizeof(needle);
+                const size_t n = (size_t)rand() % sizeof(haystack);
+
+                for(size_t i = 0; i < n; i++) haystack[i] = (char)(rand() % alphabet);
+                for(size_t i = 0; i < m; i++) needle[i] = (char)(rand() % alphabet);
+                if(round % 2 == 0) memset(needle, 0, m / 2);
+
+                string_view_t hay_sv = new_string_view(haystack, n);
+                string_view_t needle_sv = new_string_view(needle, m);
+                string_view_searcher_t searcher = new_string_view_searcher(needle_sv);
+
+                size_t count = 0;
+                for(size_t i = 0; i + m <= n; i++){
+                    if(memcmp(&haystack[i], needle, m) == 0) expected[count++] = i;
+                }
+
+                const size_t total = string_view_searcher_find_all(&searcher, hay_sv, found, n);
+                TEST_CHECK(total == count, "Expect %zu occurrences in round %d on level %d.", count, round, level);
+                for(size_t i = 0; i < count && i < total; i++){
+                    TEST_CHECK(found[i] == expected[i], "Expect occurrence %zu at %zu in round %d on level %d.",
+                               i, expected[i], round, level);
+                }
+
+                size_t pos = STRING_VIEW_NPOS;
+                for(size_t i = 0; i <= count; i++){
+                    pos = string_view_searcher_find_next(&searcher, hay_sv, pos);
+                    TEST_CHECK(pos == ((i < count) ? expected[i] : STRING_VIEW_NPOS),
+                               "Expect find_next to return occurrence %zu in round %d on level %d.", i, round, level);
+                }
+
+                TEST_CHECK(string_view_find_substring(hay_sv, needle_sv, 0) == (count > 0 ? expected[0] : STRING_VIEW_NPOS),
+                           "Expect find_substring to return the first occurrence in round %d on level %d.", round, level);
+            }
+        }
+    }
+
+    TEST_CASE("Find all the occurrences of a periodic needle"){
+        char haystack[256];
+        memset(haystack, 'a', sizeof(haystack));
+
+        string_view_t needle = new_string_view(haystack, 40);
+        string_view_searcher_t searcher = new_string_view_searcher(needle);
+
+        TEST_ASSERT(string_view_searcher_find_all(&searcher, new_string_view(haystack, sizeof(haystack)), NULL, 0)
+                    == sizeof(haystack) - 40 + 1, "Expect an occurrence at every position.");
+    }
+}
+
+TEST_SUITE(string_view_automaton) {
+
+    TEST_CASE("Find every keyword in a single pass"){
+        const string_view_t patterns[] = {
+            new_string_view_from_cstr("he"),
+            new_string_view_from_cstr("she"),
+            new_string_view_from_cstr("his"),
+            new_string_view_from_cstr("hers"),
+            STRING_VIEW_EMPTY
+        };
+        string_view_automaton_t automaton;
+        string_view_match_t matches[8];
+
+        TEST_ASSERT(string_view_automaton_init(&automaton, patterns, 5), "Expect the automaton to be built.");
+
+        const size_t count = string_view_automaton_find_all(&automaton, new_string_view_from_cstr("ushers"), matches, 8);
+        TEST_ASSERT(count == 3, "Expect 3 matches.");
+        TEST_ASSERT(matches[0].pattern == 1 && matches[0].offset == 1, "Expect 'she' at 1.");
+        TEST_ASSERT(matches[1].pattern == 0 && matches[1].offset == 2, "Expect 'he' at 2.");
+        TEST_ASSERT(matches[2].pattern == 3 && matches[2].offset == 2, "Expect 'hers' at 2.");
+
+        TEST_ASSERT(string_view_automaton_find_all(&automaton, STRING_VIEW_EMPTY, NULL, 0) == 0, "Expect no matches.");
+        string_view_automaton_free(&automaton);
+    }
+
+    TEST_CASE("Streaming scan finds matches across chunk boundaries"){
+        const char* words[] = { "abc", "bca", "cab", "aa", "abcabc" };
+        string_view_t patterns[5];
+        char text[500];
+        string_view_match_t whole[2000];
+        string_view_match_t streamed[2000];
+        string_view_automaton_t automaton;
+
+        for(size_t i = 0; i < 5; i++) patterns[i] = new_string_view_from_cstr(words[i]);
+        srand(11);
+        for(size_t i = 0; i < sizeof(text); i++) text[i] = (char)('a' + rand() % 3);
+
+        TEST_ASSERT(string_view_automaton_init(&automaton, patterns, 5), "Expect the automaton to be built.");
+
+        size_t expected = 0;
+        for(size_t p = 0; p < 5; p++){
+            string_view_searcher_t searcher = new_string_view_searcher(patterns[p]);
+            expected += string_view_searcher_find_all(&searcher, new_string_view(text, sizeof(text)), NULL, 0);
+        }
+
+        const size_t count = string_view_automaton_find_all(&automaton, new_string_view(text, sizeof(text)), whole, 2000);
+        TEST_ASSERT(count == expected, "Expect the same number of matches as the single pattern searches.");
+
+        string_view_automaton_stream_t stream = new_string_view_automaton_stream();
+        size_t streamed_count = 0;
+        for(size_t offset = 0; offset < sizeof(text); ){
+            const size_t size = 1 + (size_t)rand() % 7;
+            string_view_t chunk = string_view_substr(new_string_view(text, sizeof(text)), offset, size);
+
+            streamed_count += string_view_automaton_feed(&automaton, &stream, chunk,
+                                                         &streamed[streamed_count], 2000 - streamed_count);
+            offset += string_view_size(chunk);
+        }
+
+        TEST_ASSERT(streamed_count == count, "Expect the same matches when streaming.");
+        TEST_ASSERT(memcmp(whole, streamed, count * sizeof(string_view_match_t)) == 0,
+                    "Expect identical matches when streaming.");
+        string_view_automaton_free(&automaton);
+    }
+
+    TEST_CASE("Patterns covering every byte value"){
+        char every[256];
+        string_view_t patterns[2];
+        string_view_match_t matches[4];
+        string_view_automaton_t automaton;
+
+        for(size_t i = 0; i < 256; i++) every[i] = (char)i;
+        patterns[0] = new_string_view(every, 256);
+        patterns[1] = new_string_view("\xff\xff", 2);
+
+        TEST_ASSERT(string_view_automaton_init(&automaton, patterns, 2), "Expect the automaton to be built.");
+        TEST_ASSERT(automaton.class_count == 257, "Expect a class per byte value plus the absent class.");
+        TEST_ASSERT(string_view_automaton_find_all(&automaton, new_string_view("\0\0", 2), NULL, 0) == 0,
+                    "Expect no match for two zero bytes.");
+        TEST_ASSERT(string_view_automaton_find_all(&automaton, new_string_view("\xfe\xff\xff", 3), matches, 4) == 1
+                    && matches[0].pattern == 1 && matches[0].offset == 1, "Expect the two 0xff bytes.");
+        TEST_ASSERT(string_view_automaton_find_all(&automaton, patterns[0], matches, 4) == 1
+                    && matches[0].pattern == 0 && matches[0].offset == 0, "Expect every byte value in order.");
+        string_view_automaton_free(&automaton);
+    }
+}
+
+TEST_SUITE(string_view_split) {
+
+    TEST_CASE("Split a string view on a character"){
+        string_view_split_iter_t iter = new_string_view_split_iter_char(new_string_view_from_cstr("a,b,,c"), ',');
+        const char* expected[] = { "a", "b", "", "c" };
+        string_view_t token;
+        size_t count = 0;
+
+        while(string_view_split_next(&iter, &token)){
+            TEST_ASSERT(count < 4 && string_view_equal(token, new_string_view_from_cstr(expected[count])),
+                        "Expect the tokens 'a', 'b', '' and 'c'.");
+            count++;
+        }
+        TEST_ASSERT(count == 4, "Expect 4 tokens.");
+
+        iter = new_string_view_split_iter_char(STRING_VIEW_EMPTY, ',');
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_is_empty(token), "Expect one empty token.");
+        TEST_ASSERT(!string_view_split_next(&iter, &token), "Expect the iterator to be exhausted.");
+    }
+
+    TEST_CASE("Split a string view on a set of characters and on a substring"){
+        string_view_split_iter_t iter = new_string_view_split_iter_any(new_string_view_from_cstr("key=value;next"),
+                                                                       new_string_view_from_cstr("=;"));
+        string_view_t token;
+
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_equal(token, new_string_view_from_cstr("key")),
+                    "Expect 'key'.");
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_equal(token, new_string_view_from_cstr("value")),
+                    "Expect 'value'.");
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_equal(token, new_string_view_from_cstr("next")),
+                    "Expect 'next'.");
+        TEST_ASSERT(!string_view_split_next(&iter, &token), "Expect the iterator to be exhausted.");
+
+        iter = new_string_view_split_iter_substring(new_string_view_from_cstr("GET\r\nHost\r\n"),
+                                                    new_string_view_from_cstr("\r\n"));
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_equal(token, new_string_view_from_cstr("GET")),
+                    "Expect 'GET'.");
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_equal(token, new_string_view_from_cstr("Host")),
+                    "Expect 'Host'.");
+        TEST_ASSERT(string_view_split_next(&iter, &token) && string_view_is_empty(token), "Expect an empty token.");
+        TEST_ASSERT(!string_view_split_next(&iter, &token), "Expect the iterator to be exhausted.");
+    }
+
+    TEST_CASE("Batch split matches the split iterator"){
+        char text[700];
+        string_view_t tokens[700];
+        const char* delimiter_sets[] = { ",", " \t", "0123456789" };
+
+        srand(5);
+        for(size_t i = 0; i < sizeof(text); i++){
+            const int r = rand() % 10;
+            text[i] = (r == 0) ? ',' : (r == 1) ? ' ' : (r == 2) ? '\t' : (r == 3) ? (char)('0' + rand() % 10) : 'x';
+        }
+
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t d = 0; d < 3; d++){
+                for(size_t size = 0; size <= sizeof(text); size += 61){
+                    string_view_t sv = new_string_view(text, size);
+                    string_view_t delimiters = new_string_view_from_cstr(delimiter_sets[d]);
+                    string_view_split_iter_t iter = new_string_view_split_iter_any(sv, delimiters);
+                    const size_t count = string_view_split_into(sv, delimiters, tokens, 700);
+                    string_view_t token;
+                    size_t index = 0;
+
+                    while(string_view_split_next(&iter, &token)){
+                        TEST_CHECK(index < count && token.data == tokens[index].data && token.count == tokens[index].count,
+                                   "Expect token %zu of %zu bytes split on set %zu to match on level %d.", index, size, d, level);
+                        index++;
+                    }
+                    TEST_CHECK(index == count, "Expect %zu tokens in %zu bytes split on set %zu on level %d.",
+                               index, size, d, level);
+                }
+            }
+        }
+
+        TEST_ASSERT(string_view_split_into(new_string_view_from_cstr("a b c"), new_string_view_from_cstr(" "), tokens, 1) == 3,
+                    "Expect the total number of tokens even when the output is full.");
+    }
+}
+
+/* Creates a unique file in the temporary directory holding `content` and writes its path into
+   `path`. Nothing is left behind when it fails. */
+static bool test_create_temp_file(char* path, size_t capacity, const char* content, size_t size){
+    const char* dir = getenv("TMPDIR");
+    snprintf(path, capacity, "%s/string_view_test_XXXXXX", (dir != NULL && dir[0] != '\0') ? dir : "/tmp");
+
+    const int fd = mkstemp(path);
+    if(fd < 0) return false;
+
+    FILE* file = fdopen(fd, "wb");
+    if(file == NULL){
+        close(fd);
+        remove(path);
+        return false;
+    }
+
+    const bool written = fwrite(content, 1, size, file) == size;
+    if(fclose(file) != 0 || !written){
+        remove(path);
+        return false;
+    }
+    return true;
+}
+
+TEST_SUITE(string_view_lines) {
+
+    TEST_CASE("Iterate over the lines of a string view"){
+        string_view_line_iter_t iter = new_string_view_line_iter(new_string_view_from_cstr("first\r\n\nthird\nlast"));
+        const char* expected[] = { "first", "", "third", "last" };
+        string_view_t line;
+        size_t count = 0;
+
+        while(string_view_line_next(&iter, &line)){
+            TEST_ASSERT(count < 4 && string_view_equal(line, new_string_view_from_cstr(expected[count])),
+                        "Expect the lines 'first', '', 'third' and 'last'.");
+            count++;
+        }
+        TEST_ASSERT(count == 4, "Expect 4 lines.");
+
+        iter = new_string_view_line_iter(new_string_view_from_cstr("only\n"));
+        TEST_ASSERT(string_view_line_next(&iter, &line) && string_view_equal(line, new_string_view_from_cstr("only")),
+                    "Expect 'only'.");
+        TEST_ASSERT(!string_view_line_next(&iter, &line), "Expect no empty line after the trailing newline.");
+
+        iter = new_string_view_line_iter(STRING_VIEW_EMPTY);
+        TEST_ASSERT(!string_view_line_next(&iter, &line), "Expect no lines in an empty view.");
+    }
+
+    TEST_CASE("Keep a lone carriage return at the end of the input"){
+        string_view_line_iter_t iter = new_string_view_line_iter(new_string_view_from_cstr("first\r\nabc\r"));
+        string_view_t line;
+
+        TEST_ASSERT(string_view_line_next(&iter, &line) && string_view_equal(line, new_string_view_from_cstr("first")),
+                    "Expect the CRLF terminator to be stripped.");
+        TEST_ASSERT(string_view_line_next(&iter, &line) && string_view_equal(line, new_string_view_from_cstr("abc\r")),
+                    "Expect the final '\\r' without '\\n' to stay in the line.");
+        TEST_ASSERT(!string_view_line_next(&iter, &line), "Expect no more lines.");
+    }
+
+#ifdef STRING_VIEW_HAS_MMAP
+    TEST_CASE("Map a file and iterate over its lines"){
+        const char content[] = "alpha\r\nbeta\ngamma";
+        string_view_mmap_t map;
+        char path[512];
+
+        TEST_ASSERT(test_create_temp_file(path, sizeof(path), content, sizeof(content) - 1), "Expect the test file to be created.");
+
+        const bool opened = string_view_mmap_open(&map, path, STRING_VIEW_ADVICE_SEQUENTIAL);
+        remove(path);
+        TEST_ASSERT(opened, "Expect the file to be mapped.");
+        TEST_ASSERT(string_view_equal(map.view, new_string_view(content, sizeof(content) - 1)),
+                    "Expect the view to expose the file content.");
+        TEST_ASSERT(string_view_mmap_advise(&map, STRING_VIEW_ADVICE_RANDOM), "Expect the hint to be accepted.");
+
+        string_view_line_iter_t iter = new_string_view_line_iter(map.view);
+        string_view_t line;
+        size_t count = 0;
+        while(string_view_line_next(&iter, &line)) count++;
+        TEST_ASSERT(count == 3, "Expect 3 lines.");
+
+        string_view_mmap_close(&map);
+        TEST_ASSERT(string_view_is_empty(map.view), "Expect an empty view after closing the mapping.");
+        TEST_ASSERT(!string_view_mmap_open(&map, "this/file/does/not/exist", STRING_VIEW_ADVICE_NORMAL),
+                    "Expect a missing file to fail.");
+    }
+#endif
+}
+
+typedef struct {
+    string_view_t source;
+    size_t offset;
+} test_chunked_source_t;
+
+static ptrdiff_t test_chunked_read(void* context, char* buffer, size_t capacity){
+    test_chunked_source_t* source = context;
+    size_t count = 1 + (size_t)rand() % 13;
+
+    if(count > capacity) count = capacity;
+    if(count > source->source.count - source->offset) count = source->source.count - source->offset;
+
+    memcpy(buffer, &source->source.data[source->offset], count);
+    source->offset += count;
+    return (ptrdiff_t)count;
+}
+
+TEST_SUITE(string_view_reader) {
+
+    TEST_CASE("Read records that straddle the buffer refills"){
+        char text[2000];
+        size_t length = 0;
+
+        srand(3);
+        while(length < sizeof(text) - 100){
+            const size_t size = (size_t)rand() % ((length < 1000) ? 10 : 90);
+            memset(&text[length], 'a' + (int)(length % 26), size);
+            length += size;
+            text[length++] = '\n';
+        }
+        memcpy(&text[length], "tail", 4);
+        length += 4;
+
+        test_chunked_source_t source = { new_string_view(text, length), 0 };
+        string_view_reader_t reader;
+        string_view_line_iter_t lines = new_string_view_line_iter(new_string_view(text, length));
+        string_view_t record, line;
+        size_t records = 0, bytes = 0;
+
+        TEST_ASSERT(string_view_reader_init(&reader, 32, '\n', test_chunked_read, &source),
+                    "Expect the reader to be initialized.");
+
+        while(string_view_reader_next(&reader, &record)){
+            TEST_CHECK(string_view_line_next(&lines, &line) && string_view_equal(record, line),
+                       "Expect record %zu to match the line iterator.", records);
+            records++;
+            bytes += string_view_size(record);
+        }
+
+        TEST_ASSERT(!string_view_line_next(&lines, &line), "Expect the same number of records as the line iterator.");
+        TEST_ASSERT(!reader.error, "Expect no read errors.");
+        TEST_ASSERT(reader.records == records && reader.bytes_yielded == bytes, "Expect consistent statistics.");
+        TEST_ASSERT(reader.bytes_copied > 0 && reader.bytes_copied < length, "Expect only the record tails to be copied.");
+        TEST_ASSERT(reader.capacity > 32, "Expect the buffer to grow for records longer than the buffer.");
+        string_view_reader_free(&reader);
+    }
+}
+
+TEST_SUITE(string_view_hashing) {
+
+    TEST_CASE("Hash string views"){
+        string_view_t sv1 = new_string_view_from_cstr("Hello World");
+        string_view_t sv2 = string_view_substr(new_string_view_from_cstr("## Hello World ##"), 3, 11);
+
+        TEST_ASSERT(string_view_hash(sv1, 0) == string_view_hash(sv2, 0), "Expect equal views to have equal hashes.");
+        TEST_ASSERT(string_view_hash(sv1, 0) != string_view_hash(sv1, 1), "Expect the seed to change the hash.");
+        TEST_ASSERT(string_view_hash(STRING_VIEW_EMPTY, 0) != string_view_hash(new_string_view("\0", 1), 0),
+                    "Expect the length to be part of the hash.");
+    }
+
+    TEST_CASE("Hashes of every length are distinct"){
+        char buffer[256];
+        uint64_t hashes[257];
+
+        memset(buffer, 'x', sizeof(buffer));
+        for(size_t n = 0; n <= sizeof(buffer); n++){
+            hashes[n] = string_view_hash(new_string_view(buffer, n), 42);
+            for(size_t m = 0; m < n; m++){
+                TEST_CHECK(hashes[m] != hashes[n], "Expect the hashes of %zu and %zu bytes to differ.", m, n);
+            }
+        }
+
+        for(size_t n = 1; n <= sizeof(buffer); n++){
+            buffer[n - 1] = 'y';
+            TEST_CHECK(string_view_hash(new_string_view(buffer, sizeof(buffer)), 42) != hashes[sizeof(buffer)],
+                       "Expect a change of byte %zu to change the hash.", n - 1);
+            buffer[n - 1] = 'x';
+        }
+    }
+
+    TEST_CASE("Batch hashing matches single hashes"){
+        char buffer[128];
+        string_view_t views[37];
+        uint64_t hashes[37];
+
+        for(size_t i = 0; i < sizeof(buffer); i++) buffer[i] = (char)(i * 31);
+        for(size_t i = 0; i < 37; i++) views[i] = new_string_view(&buffer[i], (i * 7) % 40 + (i % 5 == 0 ? 0 : 1));
+
+        string_view_hash_many(views, 37, 99, hashes);
+        for(size_t i = 0; i < 37; i++){
+            TEST_CHECK(hashes[i] == string_view_hash(views[i], 99), "Expect view %zu to hash like string_view_hash.", i);
+        }
+    }
+}
+
+TEST_SUITE(string_view_map) {
+
+    TEST_CASE("Insert, lookup and remove keys"){
+        string_view_map_t map;
+        uint64_t value = 0;
+
+        TEST_ASSERT(string_view_map_init(&map, 0), "Expect the map to be initialized.");
+        TEST_ASSERT(string_view_map_insert(&map, new_string_view_from_cstr("short"), 1), "Expect the key to be inserted.");
+        TEST_ASSERT(string_view_map_insert(&map, new_string_view_from_cstr("a much longer key"), 2),
+                    "Expect the key to be inserted.");
+        TEST_ASSERT(string_view_map_insert(&map, STRING_VIEW_EMPTY, 3), "Expect the empty key to be inserted.");
+        TEST_ASSERT(string_view_map_insert(&map, new_string_view_from_cstr("short"), 4), "Expect the value to be updated.");
+        TEST_ASSERT(map.size == 3, "Expect 3 keys.");
+
+        TEST_ASSERT(string_view_map_lookup(&map, new_string_view_from_cstr("short"), &value) && value == 4,
+                    "Expect the updated value.");
+        TEST_ASSERT(string_view_map_lookup(&map, new_string_view_from_cstr("a much longer key"), &value) && value == 2,
+                    "Expect the value 2.");
+        TEST_ASSERT(!string_view_map_lookup(&map, new_string_view_from_cstr("a much longer kez"), NULL),
+                    "Expect a missing key.");
+        TEST_ASSERT(!string_view_map_lookup(&map, new_string_view("short\0", 6), NULL),
+                    "Expect the length to be part of the key.");
+
+        TEST_ASSERT(string_view_map_remove(&map, STRING_VIEW_EMPTY), "Expect the empty key to be removed.");
+        TEST_ASSERT(!string_view_map_lookup(&map, STRING_VIEW_EMPTY, NULL), "Expect the empty key to be gone.");
+        TEST_ASSERT(!string_view_map_remove(&map, STRING_VIEW_EMPTY), "Expect nothing to remove.");
+
+        TEST_ASSERT(!string_view_map_reserve(&map, SIZE_MAX / 2), "Expect a table too large to allocate to be refused.");
+        TEST_ASSERT(!string_view_map_reserve(&map, SIZE_MAX), "Expect the capacity not to overflow.");
+        TEST_ASSERT(map.size == 2 && string_view_map_lookup(&map, new_string_view_from_cstr("short"), &value) && value == 4,
+                    "Expect the map to be unchanged after a failed reserve.");
+        string_view_map_free(&map);
+    }
+
+    TEST_CASE("Map behaves like a reference dictionary"){
+        static char storage[2000][12];
+        static string_view_t keys[2000];
+        static uint64_t values[2000];
+        static bool present[2000];
+        static bool found[2000];
+
+        for(size_t i = 0; i < 2000; i++){
+            const int length = snprintf(storage[i], sizeof(storage[i]), "key-%zu", i * 7919 % 100003);
+            keys[i] = new_string_view(storage[i], (size_t)length);
+        }
+
+        FOR_EACH_SIMD_LEVEL(level){
+            string_view_map_t map;
+            if(level > STRING_VIEW_SIMD_SSE2) continue;
+            memset(present, 0, sizeof(present));
+            srand(17);
+
+            TEST_ASSERT(string_view_map_init(&map, 16), "Expect the map to be initialized.");
+            for(int op = 0; op < 20000; op++){
+                const size_t k = (size_t)rand() % 2000;
+                if(rand() % 3 == 0){
+                    TEST_CHECK(string_view_map_remove(&map, keys[k]) == present[k],
+                               "Expect operation %d to remove key %zu only if present on level %d.", op, k, level);
+                    present[k] = false;
+                }else{
+                    TEST_CHECK(string_view_map_insert(&map, keys[k], (uint64_t)op),
+                               "Expect operation %d to insert key %zu on level %d.", op, k, level);
+                    present[k] = true;
+                    values[k] = (uint64_t)op;
+                }
+            }
+
+            size_t expected = 0;
+            uint64_t results[2000];
+            for(size_t k = 0; k < 2000; k++) expected += present[k];
+
+            TEST_CHECK(map.size == expected, "Expect %zu keys on level %d.", expected, level);
+            TEST_CHECK(string_view_map_lookup_batch(&map, keys, 2000, results, found) == expected,
+                       "Expect the batch lookup to find %zu keys on level %d.", expected, level);
+            for(size_t k = 0; k < 2000; k++){
+                TEST_CHECK(found[k] == present[k] && (!present[k] || results[k] == values[k]),
+                           "Expect key %zu to match the reference dictionary on level %d.", k, level);
+            }
+
+            TEST_ASSERT(string_view_map_insert_batch(&map, keys, values, 2000), "Expect the batch to be inserted.");
+            TEST_CHECK(map.size == 2000, "Expect every key after the batch insert on level %d.", level);
+            string_view_map_free(&map);
+        }
+    }
+}
+
+typedef struct {
+    string_view_intern_pool_t* pool;
+    const string_view_t* keys;
+    size_t count;
+    size_t offset;
+    size_t* ids;
+    const char** pointers;
+} test_intern_worker_t;
+
+static void* test_intern_worker(void* argument){
+    test_intern_worker_t* worker = argument;
+
+    for(size_t i = 0; i < worker->count; i++){
+        const size_t k = (i + worker->offset) % worker->count;
+        string_view_t canonical;
+        worker->ids[k] = string_view_intern(worker->pool, worker->keys[k], &canonical);
+        worker->pointers[k] = canonical.data;
+    }
+
+    return NULL;
+}
+
+TEST_SUITE(string_view_intern) {
+
+    TEST_CASE("Intern strings in a single thread"){
+        string_view_intern_pool_t pool;
+        char buffer[] = "metric.cpu";
+        string_view_t first, second;
+
+        TEST_ASSERT(string_view_intern_pool_init(&pool, 8), "Expect the pool to be initialized.");
+
+        const size_t id = string_view_intern(&pool, new_string_view_from_cstr(buffer), &first);
+        buffer[0] = 'M';
+        TEST_ASSERT(id != STRING_VIEW_NPOS, "Expect the string to be interned.");
+        TEST_ASSERT(string_view_equal(first, new_string_view_from_cstr("metric.cpu")), "Expect the string to be copied.");
+        TEST_ASSERT(first.data[first.count] == '\0', "Expect a NUL-terminated copy.");
+
+        TEST_ASSERT(string_view_intern(&pool, new_string_view_from_cstr("metric.cpu"), &second) == id,
+                    "Expect the same id for an equal string.");
+        TEST_ASSERT(first.data == second.data, "Expect the same canonical data.");
+        TEST_ASSERT(string_view_intern(&pool, STRING_VIEW_EMPTY, NULL) != id, "Expect a distinct id for the empty string.");
+        TEST_ASSERT(string_view_intern_count(&pool) == 2, "Expect 2 interned strings.");
+
+        TEST_ASSERT(string_view_intern_find(&pool, new_string_view_from_cstr("metric.cpu"), NULL) == id,
+                    "Expect the string to be found.");
+        TEST_ASSERT(string_view_intern_find(&pool, new_string_view_from_cstr("metric.mem"), NULL) == STRING_VIEW_NPOS,
+                    "Expect a missing string.");
+        TEST_ASSERT(string_view_intern_get(&pool, id).data == first.data, "Expect the canonical view from the id.");
+
+        string_view_intern_pool_free(&pool);
+    }
+
+    TEST_CASE("Fail when the pool is full"){
+        string_view_intern_pool_t pool;
+        char storage[64][4];
+        size_t interned = 0;
+
+        TEST_ASSERT(string_view_intern_pool_init(&pool, 5), "Expect the pool to be initialized.");
+        for(size_t i = 0; i < 64; i++){
+            snprintf(storage[i], sizeof(storage[i]), "%zu", i);
+            interned += string_view_intern(&pool, new_string_view_from_cstr(storage[i]), NULL) != STRING_VIEW_NPOS;
+        }
+
+        TEST_ASSERT(interned == 5 && string_view_intern_count(&pool) == 5, "Expect as many strings as the capacity.");
+        TEST_ASSERT(pool.slot_count >= 2 * pool.capacity, "Expect the table to stay at most half full.");
+        TEST_ASSERT(string_view_intern(&pool, new_string_view_from_cstr("0"), NULL) != STRING_VIEW_NPOS,
+                    "Expect interned strings to be found in a full pool.");
+        string_view_intern_pool_free(&pool);
+    }
+
+    TEST_CASE("Intern the same strings from several threads"){
+        enum { THREADS = 4, KEYS = 5000 };
+        static char storage[KEYS][16];
+        static string_view_t keys[KEYS];
+        static size_t ids[THREADS][KEYS];
+        static const char* pointers[THREADS][KEYS];
+        test_intern_worker_t workers[THREADS];
+        pthread_t threads[THREADS];
+        string_view_intern_pool_t pool;
+
+        for(size_t i = 0; i < KEYS; i++){
+            const int length = snprintf(storage[i], sizeof(storage[i]), "host-%zu", i);
+            keys[i] = new_string_view(storage[i], (size_t)length);
+        }
+
+        TEST_ASSERT(string_view_intern_pool_init(&pool, KEYS), "Expect the pool to be initialized.");
+        for(size_t t = 0; t < THREADS; t++){
+            workers[t] = (test_intern_worker_t){ &pool, keys, KEYS, t * KEYS / THREADS, ids[t], pointers[t] };
+            pthread_create(&threads[t], NULL, test_intern_worker, &workers[t]);
+        }
+        for(size_t t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+
+        for(size_t i = 0; i < KEYS; i++){
+            TEST_CHECK(ids[0][i] != STRING_VIEW_NPOS, "Expect key %zu to be interned.", i);
+            for(size_t t = 1; t < THREADS; t++){
+                TEST_CHECK(ids[t][i] == ids[0][i] && pointers[t][i] == pointers[0][i],
+                           "Expect thread %zu to get the same id and view for key %zu.", t, i);
+            }
+            TEST_CHECK(string_view_equal(string_view_intern_get(&pool, ids[0][i]), keys[i]),
+                       "Expect id %zu to give back key %zu.", ids[0][i], i);
+        }
+
+        TEST_ASSERT(string_view_intern_count(&pool) == KEYS, "Expect each string to be interned once.");
+        string_view_intern_pool_free(&pool);
+    }
+}
+
+TEST_SUITE(string_view_arena) {
+
+    TEST_CASE("Copy string views into an arena"){
+        string_view_arena_t arena;
+        char source[] = "hello, world";
+        const string_view_t parts[] = {
+            new_string_view_from_cstr("key"),
+            new_string_view_from_cstr("="),
+            STRING_VIEW_EMPTY,
+            new_string_view_from_cstr("value")
+        };
+
+        string_view_arena_init(&arena, 0);
+
+        const string_view_t copy = string_view_arena_dup(&arena, new_string_view(source, 5));
+        char* cstr = string_view_arena_dup_cstr(&arena, new_string_view(source + 7, 5));
+        const string_view_t joined = string_view_arena_concat(&arena, parts, 4);
+        memset(source, 'x', sizeof(source) - 1);
+
+        TEST_ASSERT(string_view_equal(copy, new_string_view_from_cstr("hello")), "Expect an owned copy.");
+        TEST_ASSERT(strcmp(cstr, "world") == 0, "Expect a null-terminated copy.");
+        TEST_ASSERT(string_view_equal(joined, new_string_view_from_cstr("key=value")), "Expect the concatenation.");
+        TEST_ASSERT(joined.data[joined.count] == '\0', "Expect a null-terminated concatenation.");
+        TEST_ASSERT(arena.blocks_allocated == 1, "Expect a single block.");
+        TEST_ASSERT(arena.bytes_used == 5 + 6 + 10, "Expect the bytes used to be tracked.");
+        TEST_ASSERT(((uintptr_t)string_view_arena_alloc(&arena, 8) & 15) == 0, "Expect aligned allocations.");
+
+        string_view_arena_free(&arena);
+        TEST_ASSERT(arena.blocks_allocated == 0 && arena.bytes_used == 0, "Expect an empty arena.");
+    }
+
+    TEST_CASE("Rewind and reset reuse the blocks"){
+        string_view_arena_t arena;
+        const string_view_t text = new_string_view_from_cstr("0123456789abcdef");
+
+        string_view_arena_init(&arena, 64);
+        string_view_arena_dup(&arena, text);
+
+        const string_view_arena_mark_t mark = string_view_arena_mark(&arena);
+        for(int i = 0; i < 20; i++) string_view_arena_dup(&arena, text);
+        const size_t blocks = arena.blocks_allocated;
+        TEST_ASSERT(blocks > 1, "Expect the arena to grow.");
+
+        string_view_arena_rewind(&arena, mark);
+        TEST_ASSERT(arena.bytes_used == 16, "Expect the bytes after the mark to be released.");
+
+        const string_view_t again = string_view_arena_dup(&arena, new_string_view_from_cstr("again"));
+        TEST_ASSERT(again.data == mark.cursor, "Expect the memory after the mark to be reused.");
+
+        string_view_arena_reset(&arena);
+        for(int i = 0; i < 21; i++) string_view_arena_dup(&arena, text);
+        TEST_ASSERT(arena.blocks_allocated == blocks, "Expect no new block after a reset.");
+
+        const string_view_t empty = string_view_arena_dup(&arena, new_string_view(NULL, 0));
+        TEST_ASSERT(empty.data != NULL && empty.count == 0, "Expect an empty copy.");
+        char* big = string_view_arena_alloc(&arena, 1000);
+        TEST_ASSERT(big != NULL, "Expect allocations larger than a block.");
+        memset(big, 0, 1000);
+
+        string_view_arena_free(&arena);
+    }
+}
+
+TEST_SUITE(string_builder) {
+
+    TEST_CASE("Build a string on the heap"){
+        string_builder_t builder = new_string_builder();
+
+        TEST_ASSERT(string_view_is_empty(string_builder_view(&builder)), "Expect an empty builder.");
+        TEST_ASSERT(string_builder_append(&builder, new_string_view_from_cstr("count")), "Expect the view to be appended.");
+        TEST_ASSERT(string_builder_append_char(&builder, '='), "Expect the char to be appended.");
+        TEST_ASSERT(string_builder_append_int(&builder, -42), "Expect the integer to be appended.");
+        TEST_ASSERT(string_builder_append_char(&builder, ' '), "Expect the char to be appended.");
+        TEST_ASSERT(string_builder_append_int(&builder, INT64_MIN), "Expect the integer to be appended.");
+        TEST_ASSERT(string_builder_append_char(&builder, ' '), "Expect the char to be appended.");
+        TEST_ASSERT(string_builder_append_uint(&builder, UINT64_MAX), "Expect the integer to be appended.");
+        TEST_ASSERT(string_builder_append_uint(&builder, 0), "Expect the integer to be appended.");
+
+        TEST_ASSERT(strcmp(builder.data, "count=-42 -9223372036854775808 184467440737095516150") == 0,
+                    "Expect the formatted content.");
+
+        for(int i = 0; i < 1000; i++) string_builder_append_char(&builder, 'x');
+        TEST_ASSERT(builder.count == 52 + 1000 && builder.data[builder.count] == '\0', "Expect the builder to grow.");
+
+        string_builder_clear(&builder);
+        TEST_ASSERT(builder.count == 0 && builder.data[0] == '\0', "Expect an empty builder.");
+        string_builder_free(&builder);
+    }
+
+    TEST_CASE("Build a string in a fixed buffer"){
+        char buffer[8];
+        string_builder_t builder = new_string_builder_fixed(buffer, sizeof(buffer));
+
+        TEST_ASSERT(string_builder_append(&builder, new_string_view_from_cstr("abc")), "Expect the view to fit.");
+        TEST_ASSERT(string_builder_append_uint(&builder, 1234), "Expect the integer to fit.");
+        TEST_ASSERT(!builder.overflow, "Expect no overflow.");
+        TEST_ASSERT(!string_builder_append_char(&builder, 'x'), "Expect the char not to fit.");
+        TEST_ASSERT(builder.overflow, "Expect the overflow to be reported.");
+        TEST_ASSERT(strcmp(buffer, "abc1234") == 0, "Expect the content to be left unchanged.");
+        TEST_ASSERT(builder.data == buffer, "Expect no allocation.");
+    }
+
+    TEST_CASE("Join string views"){
+        const string_view_t views[] = {
+            new_string_view_from_cstr("a"),
+            STRING_VIEW_EMPTY,
+            new_string_view_from_cstr("bc")
+        };
+        char buffer[16];
+        string_builder_t builder = new_string_builder_fixed(buffer, sizeof(buffer));
+
+        const string_view_t joined = string_view_join(views, 3, new_string_view_from_cstr(", "));
+        TEST_ASSERT(strcmp(joined.data, "a, , bc") == 0 && joined.count == 7, "Expect the joined string.");
+        STRING_VIEW_FREE((void*)joined.data);
+
+        const string_view_t empty = string_view_join(views, 0, new_string_view_from_cstr(", "));
+        TEST_ASSERT(empty.data != NULL && empty.count == 0 && empty.data[0] == '\0', "Expect an empty string.");
+        STRING_VIEW_FREE((void*)empty.data);
+
+        TEST_ASSERT(string_builder_append_join(&builder, views, 3, new_string_view_from_cstr("/")),
+                    "Expect the views to be joined.");
+        TEST_ASSERT(strcmp(buffer, "a//bc") == 0, "Expect the joined content.");
+    }
+}
+
+TEST_SUITE(string_view_parsing) {
+
+    TEST_CASE("Parse integers"){
+        int64_t i = 0;
+        uint64_t u = 0;
+        string_view_parse_result_t result;
+
+        result = string_view_parse_i64(new_string_view_from_cstr("-1234567890123,"), &i);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OK && result.consumed == 14 && i == -1234567890123LL,
+                    "Expect a negative integer.");
+
+        result = string_view_parse_i64(new_string_view_from_cstr("-9223372036854775808"), &i);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OK && i == INT64_MIN, "Expect the smallest integer.");
+
+        result = string_view_parse_i64(new_string_view_from_cstr("9223372036854775808"), &i);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OUT_OF_RANGE && result.consumed == 19 && i == INT64_MAX,
+                    "Expect an out of range integer.");
+
+        result = string_view_parse_u64(new_string_view_from_cstr("+0000000000000000000000018446744073709551615"), &u);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OK && u == UINT64_MAX, "Expect the largest unsigned integer.");
+
+        result = string_view_parse_u64(new_string_view_from_cstr("30000000000000000000"), &u);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OUT_OF_RANGE && result.consumed == 20, "Expect an overflow.");
+
+        u = 7;
+        result = string_view_parse_u64(new_string_view_from_cstr("-1"), &u);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_INVALID && result.consumed == 0 && u == 7,
+                    "Expect an invalid unsigned integer.");
+        result = string_view_parse_i64(new_string_view_from_cstr(" 1"), &i);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_INVALID, "Expect leading whitespace to be rejected.");
+        result = string_view_parse_i64(STRING_VIEW_EMPTY, &i);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_INVALID, "Expect an empty view to be rejected.");
+    }
+
+    TEST_CASE("Parse floating-point numbers"){
+        const char* inputs[] = {
+            "0.1", "-2.5e-3", "1e23", "123456.789e3", "2.2250738585072011e-308", "4.9406564584124654e-324",
+            "1.7976931348623157e308", "9007199254740993", ".5", "3.", "1.00000000000000011102230246251565404236316680908203125",
+            "1.00000000000000011102230246251565404236316680908203124999", "7.2057594037927933e16",
+            "0.000000000000000000000000000000000000000000001e45", "179769313486231580793728971405301e276"
+        };
+
+        for(size_t k = 0; k < sizeof(inputs) / sizeof(inputs[0]); k++){
+            double expected = strtod(inputs[k], NULL), actual = 0;
+            const string_view_parse_result_t result = string_view_parse_f64(new_string_view_from_cstr(inputs[k]), &actual);
+            TEST_CHECK(result.status == STRING_VIEW_PARSE_OK && result.consumed == strlen(inputs[k])
+                       && memcmp(&expected, &actual, sizeof(double)) == 0, "Expect \"%s\" to parse like strtod.", inputs[k]);
+        }
+
+        double d = 0;
+        string_view_parse_result_t result = string_view_parse_f64(new_string_view_from_cstr("1.5e+x"), &d);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OK && result.consumed == 3 && d == 1.5,
+                    "Expect an incomplete exponent not to be consumed.");
+
+        result = string_view_parse_f64(new_string_view_from_cstr("-Infinity"), &d);
+        TEST_ASSERT(result.consumed == 9 && d < 0 && d * 0.5 == d, "Expect a negative infinity.");
+        result = string_view_parse_f64(new_string_view_from_cstr("NaN"), &d);
+        TEST_ASSERT(result.consumed == 3 && d != d, "Expect a NaN.");
+
+        result = string_view_parse_f64(new_string_view_from_cstr("1e400"), &d);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OUT_OF_RANGE && d > 1e308, "Expect an overflow.");
+        result = string_view_parse_f64(new_string_view_from_cstr("1e-400"), &d);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_OUT_OF_RANGE && d == 0, "Expect an underflow.");
+        result = string_view_parse_f64(new_string_view_from_cstr("-."), &d);
+        TEST_ASSERT(result.status == STRING_VIEW_PARSE_INVALID && result.consumed == 0, "Expect an invalid number.");
+    }
+
+    TEST_CASE("Parse columns of numbers"){
+        const string_view_t integers[] = {
+            new_string_view_from_cstr("17"), new_string_view_from_cstr("-3"), new_string_view_from_cstr("12x")
+        };
+        const string_view_t floats[] = {
+            new_string_view_from_cstr("1.25"), new_string_view_from_cstr("-0"), new_string_view_from_cstr("6e1")
+        };
+        int64_t i[3];
+        uint64_t u[3];
+        double d[3];
+
+        TEST_ASSERT(string_view_parse_i64_batch(integers, 3, i) == 2, "Expect the trailing garbage to be rejected.");
+        TEST_ASSERT(i[0] == 17 && i[1] == -3, "Expect the parsed integers.");
+        TEST_ASSERT(string_view_parse_u64_batch(integers, 3, u) == 1, "Expect the sign to be rejected.");
+        TEST_ASSERT(string_view_parse_f64_batch(floats, 3, d) == 3, "Expect every float to be parsed.");
+        TEST_ASSERT(d[0] == 1.25 && d[1] == 0 && d[2] == 60, "Expect the parsed floats.");
+    }
+}
+
+TEST_SUITE(string_view_charset) {
+
+    TEST_CASE("Build character sets"){
+        const string_view_charset_t vowels = new_string_view_charset(new_string_view_from_cstr("aeiou\xff"));
+        const string_view_charset_t digits = new_string_view_charset_from_predicate(isdigit);
+
+        TEST_ASSERT(string_view_charset_contains(&vowels, 'e'), "Expect 'e' to be a vowel.");
+        TEST_ASSERT(string_view_charset_contains(&vowels, '\xff'), "Expect high bytes to be supported.");
+        TEST_ASSERT(!string_view_charset_contains(&vowels, 'b'), "Expect 'b' not to be a vowel.");
+        TEST_ASSERT(string_view_charset_contains(&digits, '7') && !string_view_charset_contains(&digits, 'a'),
+                    "Expect the predicate to be compiled.");
+        TEST_ASSERT(new_string_view_charset(new_string_view_from_cstr("abba")).char_count == 2,
+                    "Expect small sets to list their distinct bytes.");
+        TEST_ASSERT(digits.char_count == 0, "Expect larger sets not to be listed.");
+    }
+
+    TEST_CASE("Find characters of a set"){
+        const string_view_charset_t separators = new_string_view_charset(new_string_view_from_cstr(",;"));
+        const string_view_t sv = new_string_view_from_cstr("ab,cd;ef");
+
+        TEST_ASSERT(string_view_find_first_of(sv, &separators, 0) == 2, "Expect the first separator at 2.");
+        TEST_ASSERT(string_view_find_first_of(sv, &separators, 3) == 5, "Expect the next separator at 5.");
+        TEST_ASSERT(string_view_find_first_not_of(sv, &separators, 2) == 3, "Expect a letter at 3.");
+        TEST_ASSERT(string_view_find_last_of(sv, &separators, STRING_VIEW_NPOS) == 5, "Expect the last separator at 5.");
+        TEST_ASSERT(string_view_find_last_of(sv, &separators, 4) == 2, "Expect a separator at 2 before 4.");
+        TEST_ASSERT(string_view_find_last_not_of(sv, &separators, 5) == 4, "Expect a letter at 4.");
+        TEST_ASSERT(string_view_find_first_of(sv, &separators, 8) == STRING_VIEW_NPOS, "Expect no separator.");
+        TEST_ASSERT(string_view_find_last_of(STRING_VIEW_EMPTY, &separators, 0) == STRING_VIEW_NPOS, "Expect no separator.");
+    }
+
+    TEST_CASE("Vectorized searches match a scalar scan"){
+        static char buffer[1000];
+        const char* sets[] = { "a", "xyz", " \t\r\n", "0123456789abcdefABCDEF\x80\x9f\xfe" };
+
+        srand(3);
+        for(size_t i = 0; i < sizeof(buffer); i++) buffer[i] = (rand() % 8 == 0) ? (char)(1 + rand() % 255) : 'q';
+
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t k = 0; k < sizeof(sets) / sizeof(sets[0]); k++){
+                const string_view_charset_t set = new_string_view_charset(new_string_view_from_cstr(sets[k]));
+
+                for(size_t n = 0; n <= sizeof(buffer); n += 97){
+                    const string_view_t sv = new_string_view(buffer, n);
+                    size_t first_of = STRING_VIEW_NPOS, first_not_of = STRING_VIEW_NPOS;
+                    size_t last_of = STRING_VIEW_NPOS, last_not_of = STRING_VIEW_NPOS;
+
+                    for(size_t i = 0; i < n; i++){
+                        const bool member = strchr(sets[k], buffer[i]) != NULL;
+                        if(member && first_of == STRING_VIEW_NPOS) first_of = i;
+                        if(!member && first_not_of == STRING_VIEW_NPOS) first_not_of = i;
+                        if(member) last_of = i;
+                        else last_not_of = i;
+                    }
+
+                    TEST_CHECK(string_view_find_first_of(sv, &set, 0) == first_of,
+                               "Expect find_first_of with set %zu on %zu bytes on level %d.", k, n, level);
+                    TEST_CHECK(string_view_find_first_not_of(sv, &set, 0) == first_not_of,
+                               "Expect find_first_not_of with set %zu on %zu bytes on level %d.", k, n, level);
+                    TEST_CHECK(string_view_find_last_of(sv, &set, STRING_VIEW_NPOS) == last_of,
+                               "Expect find_last_of with set %zu on %zu bytes on level %d.", k, n, level);
+                    TEST_CHECK(string_view_find_last_not_of(sv, &set, STRING_VIEW_NPOS) == last_not_of,
+                               "Expect find_last_not_of with set %zu on %zu bytes on level %d.", k, n, level);
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Trim characters of a set"){
+        const string_view_charset_t quotes = new_string_view_charset(new_string_view_from_cstr("\"'"));
+        string_view_t sv = new_string_view_from_cstr("\"'quoted'\"");
+        string_view_t only = new_string_view_from_cstr("''''");
+        string_view_t empty = new_string_view(NULL, 0);
+        string_view_t spaces = new_string_view_from_cstr(" \t\v\f\r\n");
+
+        string_view_trim_chars(&sv, &quotes);
+        string_view_trim_chars(&only, &quotes);
+        string_view_trim(&empty);
+        string_view_trim_left(&spaces);
+
+        TEST_ASSERT(string_view_equal(sv, new_string_view_from_cstr("quoted")), "Expect the quotes to be trimmed.");
+        TEST_ASSERT(string_view_is_empty(only), "Expect an empty view.");
+        TEST_ASSERT(string_view_is_empty(empty), "Expect an empty view to stay empty.");
+        TEST_ASSERT(string_view_is_empty(spaces), "Expect every whitespace character to be trimmed.");
+    }
+}
+
+static int test_compare_views(const void* a, const void* b){
+    return string_view_compare(*(const string_view_t*)a, *(const string_view_t*)b);
+}
+
+TEST_SUITE(string_view_ordering) {
+
+    TEST_CASE("Compare string views lexicographically"){
+        const string_view_t nul1 = new_string_view("a\0b", 3);
+        const string_view_t nul2 = new_string_view("a\0c", 3);
+
+        TEST_ASSERT(string_view_compare(new_string_view_from_cstr("b"), new_string_view_from_cstr("abc")) > 0,
+                    "Expect a lexicographic order rather than a length order.");
+        TEST_ASSERT(string_view_compare(nul1, nul2) < 0, "Expect embedded null characters to be compared.");
+        TEST_ASSERT(string_view_compare(new_string_view("\xff", 1), new_string_view("a", 1)) > 0,
+                    "Expect bytes to be compared as unsigned values.");
+        TEST_ASSERT(!string_view_equal(nul1, nul2), "Expect different views.");
+        TEST_ASSERT(string_view_starts_with(nul2, new_string_view("a\0", 2)), "Expect a prefix with a null character.");
+        TEST_ASSERT(!string_view_ends_with(nul2, new_string_view("\0b", 2)), "Expect a different suffix.");
+        TEST_ASSERT(string_view_compare(STRING_VIEW_EMPTY, new_string_view(NULL, 0)) == 0, "Expect equal empty views.");
+    }
+
+    TEST_CASE("Sort string views"){
+        enum { COUNT = 5000 };
+        static char storage[COUNT * 20];
+        static string_view_t sorted[COUNT], expected[COUNT];
+        size_t offset = 0;
+
+        srand(11);
+        for(size_t i = 0; i < COUNT; i++){
+            const size_t length = (size_t)rand() % 20;
+            for(size_t k = 0; k < length; k++) storage[offset + k] = (k < 9) ? "ab\0"[rand() % 3] : (char)rand();
+            sorted[i] = expected[i] = new_string_view(storage + offset, length);
+            offset += length;
+        }
+
+        string_view_sort(sorted, COUNT);
+        qsort(expected, COUNT, sizeof(expected[0]), test_compare_views);
+
+        for(size_t i = 0; i < COUNT; i++){
+            TEST_CHECK(string_view_equal(sorted[i], expected[i]), "Expect view %zu in the order of string_view_compare.", i);
+        }
+    }
+}
+
+TEST_SUITE(string_view_prefixed) {
+
+    TEST_CASE("Convert prefixed string views"){
+        const string_view_t short_sv = new_string_view_from_cstr("inline text");
+        const string_view_t long_sv = new_string_view_from_cstr("a string stored out of line");
+        const string_view_prefixed_t short_prefixed = new_string_view_prefixed(short_sv);
+        const string_view_prefixed_t long_prefixed = new_string_view_prefixed(long_sv);
+
+        TEST_ASSERT(sizeof(string_view_prefixed_t) == 16 || sizeof(void*) != 8, "Expect a 16-byte layout.");
+        TEST_ASSERT(string_view_equal(string_view_prefixed_to_view(&short_prefixed), short_sv), "Expect the inline string.");
+        TEST_ASSERT(string_view_prefixed_to_view(&long_prefixed).data == long_sv.data, "Expect the original data.");
+        TEST_ASSERT(string_view_prefixed_hash(&long_prefixed, 7) == string_view_hash(long_sv, 7),
+                    "Expect the same hash as the string view.");
+        TEST_ASSERT(string_view_prefixed_hash(&short_prefixed, 7) == string_view_hash(short_sv, 7),
+                    "Expect the same hash as the string view.");
+    }
+
+    TEST_CASE("Compare prefixed string views"){
+        enum { COUNT = 300 };
+        static char storage[COUNT][20];
+        static char copies[COUNT][20];
+        static string_view_prefixed_t prefixed[COUNT], duplicates[COUNT];
+        static string_view_t views[COUNT];
+
+        srand(13);
+        for(size_t i = 0; i < COUNT; i++){
+            const size_t length = (size_t)rand() % 20;
+            for(size_t k = 0; k < length; k++) storage[i][k] = (k < 6) ? "ab\0"[rand() % 3] : (char)('a' + rand() % 2);
+            memcpy(copies[i], storage[i], length);
+            views[i] = new_string_view(storage[i], length);
+            prefixed[i] = new_string_view_prefixed(views[i]);
+            duplicates[i] = new_string_view_prefixed(new_string_view(copies[i], length));
+        }
+
+        for(size_t i = 0; i < COUNT; i++){
+            TEST_CHECK(string_view_prefixed_equal(&prefixed[i], &duplicates[i]), "Expect view %zu to equal its copy.", i);
+            for(size_t j = 0; j < COUNT; j++){
+                const int expected = string_view_compare(views[i], views[j]);
+                const int actual = string_view_prefixed_compare(&prefixed[i], &prefixed[j]);
+                TEST_CHECK((expected < 0) == (actual < 0) && (expected > 0) == (actual > 0),
+                           "Expect views %zu and %zu to compare like string_view_compare.", i, j);
+                TEST_CHECK(string_view_prefixed_equal(&prefixed[i], &prefixed[j]) == (expected == 0),
+                           "Expect views %zu and %zu to be equal only if they compare equal.", i, j);
+            }
+        }
+    }
+}
+
+TEST_SUITE(string_view_parallel) {
+
+    TEST_CASE("Parallel scans match the sequential ones"){
+        const size_t chunk = (size_t)1 << 20;
+        const size_t size = 5 * chunk + 12345;
+        char* data = malloc(size);
+        string_view_thread_pool_t pool;
+        size_t expected[64], actual[64];
+
+        TEST_ASSERT(data != NULL && string_view_thread_pool_init(&pool, 4), "Expect the pool to be started.");
+
+        memset(data, 'a', size);
+        const string_view_t haystack = new_string_view(data, size);
+        const string_view_t needle = new_string_view_from_cstr("needle");
+        const string_view_searcher_t searcher = new_string_view_searcher(needle);
+
+        TEST_ASSERT(string_view_parallel_find_first(&pool, haystack, needle) == STRING_VIEW_NPOS, "Expect no occurrence.");
+
+        /* Occurrences straddling chunk boundaries and at both ends. */
+        const size_t offsets[] = { 2 * chunk - 3, chunk - 1, 4 * chunk - 5, 3 * chunk, 0, size - 6 };
+        for(size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++){
+            memcpy(&data[offsets[i]], "needle", 6);
+            TEST_CHECK(string_view_parallel_find_first(&pool, haystack, needle)
+                       == string_view_find_substring(haystack, needle, 0), "Expect the first occurrence after writing one at %zu.", offsets[i]);
+        }
+
+        const size_t total = string_view_searcher_find_all(&searcher, haystack, expected, 64);
+        TEST_CHECK(string_view_parallel_find_all(&pool, haystack, needle, actual, 64) == total
+                   && memcmp(actual, expected, total * sizeof(size_t)) == 0, "Expect the %zu sequential occurrences.", total);
+        TEST_CHECK(string_view_parallel_find_all(&pool, haystack, needle, actual, 2) == total
+                   && actual[0] == expected[0] && actual[1] == expected[1],
+                   "Expect the total and the first two occurrences in a short array.");
+        TEST_CHECK(string_view_parallel_count(&pool, haystack, needle) == total, "Expect %zu occurrences to be counted.", total);
+
+        const string_view_t overlapping = new_string_view_from_cstr("aaaa");
+        const string_view_searcher_t run = new_string_view_searcher(overlapping);
+        TEST_CHECK(string_view_parallel_count(&pool, haystack, overlapping) == string_view_searcher_find_all(&run, haystack, NULL, 0),
+                   "Expect overlapping occurrences to be counted.");
+        TEST_CHECK(string_view_parallel_count(&pool, haystack, new_string_view_from_cstr("e"))
+                   == string_view_count_char(haystack, 'e'), "Expect single-byte needles to be counted.");
+
+        string_view_thread_pool_free(&pool);
+        free(data);
+    }
+
+    TEST_CASE("Small inputs and single-thread pools"){
+        string_view_thread_pool_t pool;
+        size_t positions[4];
+
+        TEST_ASSERT(string_view_thread_pool_init(&pool, 1), "Expect the pool to be started.");
+        TEST_ASSERT(string_view_parallel_find_first(&pool, new_string_view_from_cstr("abcabc"),
+                                                    new_string_view_from_cstr("ca")) == 2, "Expect the occurrence at 2.");
+        TEST_ASSERT(string_view_parallel_find_all(&pool, new_string_view_from_cstr("abcabc"), new_string_view_from_cstr("bc"),
+                                                  positions, 4) == 2 && positions[1] == 4, "Expect two occurrences.");
+        TEST_ASSERT(string_view_parallel_count(&pool, new_string_view_from_cstr("abc"), new_string_view_from_cstr("abcd")) == 0,
+                    "Expect no occurrence of a longer needle.");
+        string_view_thread_pool_free(&pool);
+
+        TEST_ASSERT(string_view_thread_pool_init(&pool, 0) && pool.thread_count >= 1,
+                    "Expect one thread per online processor.");
+        string_view_thread_pool_free(&pool);
+    }
+}
+
+TEST_SUITE(string_view_counting) {
+
+    TEST_CASE("Count characters across the counter flush boundaries"){
+        const size_t size = 3 * 255 * 64 + 77;
+        char* data = malloc(size);
+
+        TEST_ASSERT(data != NULL, "Expect the buffer to be allocated.");
+
+        /* Every byte matches, which saturates the per-byte counters before each flush. */
+        memset(data, 'x', size);
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t n = size - 130; n <= size; n++){
+                TEST_CHECK(string_view_count_char(new_string_view(data, n), 'x') == n,
+                           "Expect %zu matches in %zu matching bytes on level %d.", n, n, level);
+            }
+        }
+
+        for(size_t i = 0; i < size; i++){
+            data[i] = (char)((i * 7919u) % 251u);
+        }
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t start = 0; start < 3; start++){
+                size_t expected = 0;
+                for(size_t i = start; i < size; i++){
+                    expected += data[i] == (char)200;
+                }
+                TEST_CHECK(string_view_count_char(new_string_view(data + start, size - start), (char)200) == expected,
+                           "Expect %zu matches from offset %zu on level %d.", expected, start, level);
+            }
+        }
+
+        free(data);
+    }
+
+    TEST_CASE("Count lines"){
+        TEST_ASSERT(string_view_count_lines(STRING_VIEW_EMPTY) == 0, "Expect no lines in an empty view.");
+        TEST_ASSERT(string_view_count_lines(new_string_view_from_cstr("only")) == 1, "Expect one unterminated line.");
+        TEST_ASSERT(string_view_count_lines(new_string_view_from_cstr("only\n")) == 1, "Expect one terminated line.");
+        TEST_ASSERT(string_view_count_lines(new_string_view_from_cstr("first\r\n\nthird\nlast")) == 4, "Expect 4 lines.");
+        TEST_ASSERT(string_view_count_lines(new_string_view_from_cstr("\n\n\n")) == 3, "Expect 3 empty lines.");
+    }
+}
+
+TEST_SUITE(string_view_utf8) {
+
+    TEST_CASE("Validate UTF-8"){
+        const char* valid[] = { "", "plain ascii", "caf\xc3\xa9", "\xe2\x82\xac 10", "\xf0\x9f\x98\x80!", "\xef\xbf\xbf\xf4\x8f\xbf\xbf" };
+        const char* invalid[] = { "\xc0\xaf", "\xe0\x80\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xf0\x80\x80\x80", "\x80", "\xff", "\xe2\x82" };
+        static char buffer[300];
+
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++){
+                TEST_CHECK(string_view_utf8_validate(new_string_view_from_cstr(valid[i])) == STRING_VIEW_NPOS,
+                           "Expect valid input %zu to be accepted on level %d.", i, level);
+            }
+
+            /* Place every invalid sequence at each offset of a long ASCII run, across the block boundaries. */
+            for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++){
+                const size_t length = strlen(invalid[i]);
+                for(size_t offset = 0; offset + length <= 140; offset++){
+                    memset(buffer, 'x', sizeof(buffer));
+                    memcpy(&buffer[offset], invalid[i], length);
+                    TEST_CHECK(string_view_utf8_validate(new_string_view(buffer, 140)) == offset,
+                               "Expect invalid input %zu to be located at %zu on level %d.", i, offset, level);
+                    TEST_CHECK(string_view_utf8_validate(new_string_view(buffer, offset + length)) == offset,
+                               "Expect invalid input %zu to be located at the end, %zu, on level %d.", i, offset, level);
+                }
+            }
+
+            for(size_t offset = 0; offset + 4 <= sizeof(buffer); offset++){
+                memset(buffer, 'x', sizeof(buffer));
+                memcpy(&buffer[offset], "\xf0\x9f\x98\x80", 4);
+                TEST_CHECK(string_view_utf8_validate(new_string_view(buffer, sizeof(buffer))) == STRING_VIEW_NPOS,
+                           "Expect a 4-byte sequence at %zu to be accepted on level %d.", offset, level);
+            }
+        }
+    }
+
+    TEST_CASE("Count code points and slice on their boundaries"){
+        const string_view_t text = new_string_view_from_cstr("a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80z");
+        static char buffer[1000];
+
+        TEST_ASSERT(string_view_utf8_length(text) == 5, "Expect 5 code points.");
+        TEST_ASSERT(string_view_equal(string_view_utf8_substr(text, 1, 2), new_string_view_from_cstr("\xc3\xa9\xe2\x82\xac")),
+                    "Expect the second and third code points.");
+        TEST_ASSERT(string_view_equal(string_view_utf8_substr(text, 3, 100), new_string_view_from_cstr("\xf0\x9f\x98\x80z")),
+                    "Expect the count to be clamped.");
+        TEST_ASSERT(string_view_utf8_substr(text, 5, 1).count == 0, "Expect an empty view past the end.");
+
+        for(size_t i = 0; i < sizeof(buffer) / 2; i++){
+            memcpy(&buffer[2 * i], "\xc3\xa9", 2);
+        }
+        const string_view_t accents = new_string_view(buffer, sizeof(buffer));
+        const string_view_t slice = string_view_utf8_substr(accents, 321, 77);
+
+        TEST_ASSERT(string_view_utf8_length(accents) == 500, "Expect 500 code points.");
+        TEST_ASSERT(slice.data == &buffer[642] && slice.count == 154, "Expect the slice to start and end on a lead byte.");
+    }
+
+    TEST_CASE("Iterate over code points"){
+        string_view_utf8_iter_t iter = new_string_view_utf8_iter(new_string_view_from_cstr("a\xe2\x82\xac\xe2\x82z\xff"));
+        const uint32_t expected[] = { 'a', 0x20ac, 0xfffd, 'z', 0xfffd };
+        uint32_t code_point;
+        size_t count = 0;
+
+        while(string_view_utf8_next(&iter, &code_point)){
+            TEST_ASSERT(count < 5 && code_point == expected[count], "Expect the decoded code points.");
+            count++;
+        }
+        TEST_ASSERT(count == 5, "Expect one replacement character per ill-formed subpart.");
+    }
+}
+
+TEST_SUITE(string_view_csv) {
+
+    TEST_CASE("Read quoted and unquoted fields"){
+        const string_view_t input = new_string_view_from_cstr(
+            "name,quote,year\r\n"
+            "Ada,\"Hello, \"\"world\"\"\",1843\n"
+            "\n"
+            "Bob,\"multi\nline\",\r\n"
+            "last,row");
+        const char* expected[][3] = {
+            { "name", "quote", "year" },
+            { "Ada", "Hello, \"world\"", "1843" },
+            { "", NULL, NULL },
+            { "Bob", "multi\nline", "" },
+            { "last", "row", NULL }
+        };
+        const size_t counts[] = { 3, 3, 1, 3, 2 };
+        string_view_arena_t arena;
+        string_view_t fields[3];
+        size_t rows = 0, count;
+
+        string_view_arena_init(&arena, 0);
+        string_view_csv_reader_t reader = new_string_view_csv_reader(input, ',', &arena);
+
+        while(string_view_csv_next_row(&reader, fields, 3, &count)){
+            TEST_ASSERT(rows < 5 && count == counts[rows], "Expect the number of fields of each row.");
+            for(size_t i = 0; i < count; i++){
+                TEST_CHECK(string_view_equal(fields[i], new_string_view_from_cstr(expected[rows][i])),
+                           "Expect field %zu of row %zu to be \"%s\".", i, rows, expected[rows][i]);
+            }
+            rows++;
+        }
+
+        TEST_ASSERT(rows == 5, "Expect 5 rows.");
+        TEST_ASSERT(arena.bytes_used > 0, "Expect the escaped field to be copied into the arena.");
+        string_view_arena_free(&arena);
+    }
+
+    TEST_CASE("Fields point into the input"){
+        static char buffer[2000];
+        string_view_t fields[2];
+        size_t count, rows = 0;
+
+        /* Rows straddle the 64-byte blocks, and so do the quoted tabs. */
+        for(size_t i = 0; i < 100; i++){
+            memcpy(&buffer[i * 20], "field\t\"quo\tted\"\t!!!\n", 20);
+        }
+
+        string_view_csv_reader_t reader = new_string_view_csv_reader(new_string_view(buffer, sizeof(buffer)), '\t', NULL);
+        while(string_view_csv_next_row(&reader, fields, 2, &count)){
+            TEST_CHECK(count == 3, "Expect 3 fields in row %zu.", rows);
+            TEST_CHECK(fields[0].data == &buffer[rows * 20] && fields[0].count == 5,
+                       "Expect the first field of row %zu to point into the buffer.", rows);
+            TEST_CHECK(fields[1].data == &buffer[rows * 20 + 7] && fields[1].count == 7,
+                       "Expect the quoted field of row %zu to point into the buffer.", rows);
+            rows++;
+        }
+
+        TEST_ASSERT(rows == 100, "Expect 100 rows.");
+
+        reader = new_string_view_csv_reader(STRING_VIEW_EMPTY, ',', NULL);
+        TEST_ASSERT(!string_view_csv_next_row(&reader, fields, 2, &count), "Expect no rows in an empty input.");
+    }
+}
+
+TEST_SUITE(string_view_http) {
+
+    TEST_CASE("Parse a request head"){
+        const char text[] = "GET /index.html?q=1 HTTP/1.1\r\n"
+                            "Host: example.com\r\n"
+                            "User-Agent:  curl/8.0 \t\r\n"
+                            "X-Empty:\r\n"
+                            "\r\n"
+                            "body";
+        string_view_http_request_t request;
+        string_view_http_header_t headers[4];
+        size_t count = 4;
+
+        const int length = string_view_http_parse_request(new_string_view_from_cstr(text), 0, &request, headers, &count);
+
+        TEST_ASSERT(length == (int)(sizeof(text) - 1 - 4), "Expect the head to end before the body.");
+        TEST_ASSERT(string_view_equal(request.method, new_string_view_from_cstr("GET")), "Expect the method 'GET'.");
+        TEST_ASSERT(string_view_equal(request.path, new_string_view_from_cstr("/index.html?q=1")), "Expect the path.");
+        TEST_ASSERT(request.minor_version == 1 && count == 3, "Expect HTTP/1.1 with 3 headers.");
+        TEST_ASSERT(string_view_equal(headers[1].value, new_string_view_from_cstr("curl/8.0")), "Expect the value to be trimmed.");
+        TEST_ASSERT(headers[2].value.count == 0, "Expect an empty value.");
+        TEST_ASSERT(headers[0].name.data == &text[30], "Expect the views to point into the buffer.");
+
+        TEST_ASSERT(string_view_http_find_header(headers, count, new_string_view_from_cstr("user-AGENT")) == &headers[1],
+                    "Expect a case-insensitive lookup.");
+        TEST_ASSERT(string_view_http_find_header(headers, count, new_string_view_from_cstr("Hosts")) == NULL,
+                    "Expect no header 'Hosts'.");
+    }
+
+    TEST_CASE("Parse a request arriving in pieces"){
+        const char text[] = "POST /submit HTTP/1.0\nContent-Length: 3\n\n";
+        string_view_http_request_t request;
+        string_view_http_header_t headers[2];
+        size_t last_len = 0, count = 0;
+        int result = STRING_VIEW_HTTP_INCOMPLETE;
+
+        for(size_t length = 1; length < sizeof(text); length++){
+            count = 2;
+            result = string_view_http_parse_request(new_string_view(text, length), last_len, &request, headers, &count);
+            TEST_CHECK((length < sizeof(text) - 1) == (result == STRING_VIEW_HTTP_INCOMPLETE),
+                       "Expect only the complete request to parse, not its %zu-byte prefix.", length);
+            last_len = length;
+        }
+
+        TEST_ASSERT(result == (int)(sizeof(text) - 1) && request.minor_version == 0 && count == 1,
+                    "Expect the complete request to be parsed.");
+    }
+
+    TEST_CASE("Reject malformed requests"){
+        const char* invalid[] = {
+            "GET /a HTTP/2.0\r\n\r\n",
+            "G(T /a HTTP/1.1\r\n\r\n",
+            "GET  HTTP/1.1\r\n\r\n",
+            "GET /a HTTP/1.1\r\nBad Name: x\r\n\r\n",
+            "GET /a HTTP/1.1\r\nName: x\r\n folded\r\n\r\n",
+            "GET /a HTTP/1.1\r\nName: a\x01z\r\n\r\n",
+            "GET /a HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n"
+        };
+        string_view_http_request_t request;
+        string_view_http_header_t headers[2];
+
+        for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++){
+            size_t count = 2;
+            TEST_CHECK(string_view_http_parse_request(new_string_view_from_cstr(invalid[i]), 0, &request, headers, &count)
+                       == STRING_VIEW_HTTP_ERROR, "Expect malformed request %zu to be rejected.", i);
+        }
+    }
+}
+
+TEST_SUITE(string_view_case_insensitive) {
+
+    TEST_CASE("Compare ignoring ASCII case"){
+        const string_view_t keyword = new_string_view_from_cstr("SELECT");
+
+        TEST_ASSERT(string_view_iequal(keyword, new_string_view_from_cstr("select")), "Expect 'SELECT' to equal 'select'.");
+        TEST_ASSERT(!string_view_iequal(keyword, new_string_view_from_cstr("selects")), "Expect different lengths to differ.");
+        TEST_ASSERT(!string_view_iequal(new_string_view_from_cstr("@[`{"), new_string_view_from_cstr("`{@[")),
+                    "Expect only letters to be folded.");
+        TEST_ASSERT(!string_view_iequal(new_string_view_from_cstr("\xc3\x89"), new_string_view_from_cstr("\xc3\xa9")),
+                    "Expect non-ASCII bytes to match exactly.");
+        TEST_ASSERT(string_view_icompare(new_string_view_from_cstr("apple"), new_string_view_from_cstr("BANANA")) < 0,
+                    "Expect 'apple' before 'BANANA'.");
+        TEST_ASSERT(string_view_icompare(new_string_view_from_cstr("Zebra"), new_string_view_from_cstr("zEB")) > 0,
+                    "Expect the longer string after its prefix.");
+        TEST_ASSERT(string_view_icompare(STRING_VIEW_EMPTY, STRING_VIEW_EMPTY) == 0, "Expect empty views to be equal.");
+        TEST_ASSERT(string_view_istarts_with(new_string_view_from_cstr("Content-Type"), new_string_view_from_cstr("content-")),
+                    "Expect the prefix 'content-'.");
+        TEST_ASSERT(string_view_iends_with(new_string_view_from_cstr("www.Example.COM"), new_string_view_from_cstr(".com")),
+                    "Expect the suffix '.com'.");
+        TEST_ASSERT(!string_view_iends_with(new_string_view_from_cstr("com"), new_string_view_from_cstr(".com")),
+                    "Expect no suffix longer than the view.");
+    }
+
+    TEST_CASE("Vectorized folding matches a scalar scan"){
+        static char upper[300], lower[300];
+
+        for(size_t i = 0; i < sizeof(upper); i++){
+            lower[i] = (char)('a' + i % 26);
+            upper[i] = (char)('A' + i % 26);
+        }
+        memcpy(&upper[250], "NeEdLe", 6);
+
+        FOR_EACH_SIMD_LEVEL(level){
+            for(size_t n = 0; n <= 240; n++){
+                TEST_CHECK(string_view_iequal(new_string_view(upper, n), new_string_view(lower, n)),
+                           "Expect %zu bytes to be equal ignoring case on level %d.", n, level);
+            }
+            lower[200] = '!';
+            TEST_CHECK(string_view_icompare(new_string_view(upper, 240), new_string_view(lower, 240)) > 0,
+                       "Expect a letter to sort after '!' on level %d.", level);
+            lower[200] = (char)('a' + 200 % 26);
+
+            const string_view_t haystack = new_string_view(upper, sizeof(upper));
+            TEST_CHECK(string_view_ifind(haystack, new_string_view_from_cstr("needle"), 0) == 250,
+                       "Expect 'needle' at 250 on level %d.", level);
+            TEST_CHECK(string_view_ifind(haystack, new_string_view_from_cstr("xyzab"), 0) == 23,
+                       "Expect 'xyzab' at 23 on level %d.", level);
+            TEST_CHECK(string_view_ifind(haystack, new_string_view_from_cstr("xyzab"), 24) == 49,
+                       "Expect the next 'xyzab' at 49 on level %d.", level);
+            TEST_CHECK(string_view_ifind(haystack, new_string_view_from_cstr("n"), 14) == 39,
+                       "Expect the next 'n' at 39 on level %d.", level);
+            TEST_CHECK(string_view_ifind(haystack, new_string_view_from_cstr("needles"), 0) == STRING_VIEW_NPOS,
+                       "Expect no 'needles' on level %d.", level);
+            TEST_CHECK(string_view_ifind(haystack, STRING_VIEW_EMPTY, 7) == 7,
+                       "Expect the empty needle at the start on level %d.", level);
+        }
+    }
+
+    TEST_CASE("Long periodic needles"){
+        static char haystack[4096], needle[100];
+
+        for(size_t i = 0; i < sizeof(haystack); i++) haystack[i] = (i % 3 == 0) ? 'A' : 'a';
+        for(size_t i = 0; i < sizeof(needle); i++) needle[i] = (i % 2 == 0) ? 'a' : 'A';
+        needle[sizeof(needle) - 1] = 'B';
+        memcpy(&haystack[3000], needle, sizeof(needle));
+        haystack[3000 + sizeof(needle) - 1] = 'b';
+
+        const string_view_t hay = new_string_view(haystack, sizeof(haystack));
+        TEST_ASSERT(string_view_ifind(hay, new_string_view(needle, sizeof(needle)), 0) == 3000,
+                    "Expect the needle ending in 'B' to be found.");
+        TEST_ASSERT(string_view_ifind(hay, new_string_view(needle, sizeof(needle)), 3001) == STRING_VIEW_NPOS,
+                    "Expect no match past the only occurrence.");
+        TEST_ASSERT(string_view_ifind(hay, new_string_view(needle, 64), 5) == 5,
+                    "Expect a run of letters to match at any position.");
+
+        needle[sizeof(needle) - 1] = 'C';
+        TEST_ASSERT(string_view_ifind(hay, new_string_view(needle, sizeof(needle)), 0) == STRING_VIEW_NPOS,
+                    "Expect a needle that is not in the text to be absent.");
+    }
+}
+
+TEST_SUITE(string_view_perfect_hash) {
+
+    TEST_CASE("Look up keywords"){
+        const char* words[] = {
+            "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+            "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+            "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+            "volatile", "while", "_Bool", "_Complex", "_Imaginary"
+        };
+        const size_t count = sizeof(words) / sizeof(words[0]);
+        string_view_t keys[sizeof(words) / sizeof(words[0])];
+        string_view_mph_t mph;
+
+        for(size_t i = 0; i < count; i++) keys[i] = new_string_view_from_cstr(words[i]);
+        TEST_ASSERT(string_view_mph_build(&mph, keys, count), "Expect the perfect hash to be built.");
+
+        for(size_t i = 0; i < count; i++){
+            TEST_CHECK(string_view_mph_lookup(&mph, new_string_view_from_cstr(words[i])) == i,
+                       "Expect '%s' to map to %zu.", words[i], i);
+        }
+        TEST_ASSERT(string_view_mph_lookup(&mph, new_string_view_from_cstr("identifier")) == STRING_VIEW_NPOS,
+                    "Expect identifiers not to be keywords.");
+        TEST_ASSERT(string_view_mph_lookup(&mph, new_string_view_from_cstr("whilE")) == STRING_VIEW_NPOS,
+                    "Expect the lookup to be case-sensitive.");
+        TEST_ASSERT(string_view_mph_lookup(&mph, STRING_VIEW_EMPTY) == STRING_VIEW_NPOS, "Expect the empty view to be absent.");
+
+        FILE* out = tmpfile();
+        char generated[8192];
+        TEST_ASSERT(out != NULL && string_view_mph_write_header(&mph, out, "c_keyword"), "Expect the table to be written.");
+        rewind(out);
+        generated[fread(generated, 1, sizeof(generated) - 1, out)] = '\0';
+        fclose(out);
+
+        TEST_ASSERT(strstr(generated, "static inline size_t c_keyword_lookup(string_view_t key)") != NULL
+                    && strstr(generated, "{ \"_Imaginary\", 10 }") != NULL, "Expect the keys and the lookup function.");
+        string_view_mph_free(&mph);
+    }
+
+    TEST_CASE("Reject duplicates and accept empty sets"){
+        const string_view_t keys[] = {
+            new_string_view_from_cstr("a"), new_string_view_from_cstr("b"), new_string_view_from_cstr("a")
+        };
+        string_view_mph_t mph;
+
+        TEST_ASSERT(!string_view_mph_build(&mph, keys, 3), "Expect duplicate keys to be rejected.");
+        TEST_ASSERT(string_view_mph_build(&mph, keys, 0), "Expect an empty set to be accepted.");
+        TEST_ASSERT(string_view_mph_lookup(&mph, keys[0]) == STRING_VIEW_NPOS, "Expect nothing in an empty set.");
+        string_view_mph_free(&mph);
+    }
+}
+
+typedef struct {
+    char keys[8][32];
+    size_t count;
+} test_art_collector_t;
+
+static bool test_collect_art_key(void* context, string_view_t key, uint64_t value){
+    test_art_collector_t* collector = context;
+    (void)value;
+
+    if(collector->count == 8) return false;
+    memcpy(collector->keys[collector->count], key.data, key.count);
+    collector->keys[collector->count++][key.count] = '\0';
+    return true;
+}
+
+TEST_SUITE(string_view_radix_tree) {
+
+    TEST_CASE("Route with longest-prefix matches"){
+        const char* routes[] = { "/", "/api", "/api/v1/", "/api/v1/users", "/api/v2/", "/static/" };
+        string_view_art_t tree;
+        size_t length;
+        uint64_t value;
+
+        string_view_art_init(&tree);
+        for(size_t i = 0; i < 6; i++){
+            TEST_ASSERT(string_view_art_insert(&tree, new_string_view_from_cstr(routes[i]), i), "Expect the route to be inserted.");
+        }
+        TEST_ASSERT(string_view_art_insert(&tree, new_string_view_from_cstr("/api"), 10) && tree.size == 6,
+                    "Expect a second insertion to replace the value.");
+
+        TEST_ASSERT(string_view_art_lookup(&tree, new_string_view_from_cstr("/api"), &value) && value == 10, "Expect '/api'.");
+        TEST_ASSERT(!string_view_art_lookup(&tree, new_string_view_from_cstr("/api/v1"), NULL), "Expect no '/api/v1'.");
+        TEST_ASSERT(string_view_art_longest_prefix(&tree, new_string_view_from_cstr("/api/v1/users/42"), &length, &value)
+                    && length == 13 && value == 3, "Expect '/api/v1/users'.");
+        TEST_ASSERT(string_view_art_longest_prefix(&tree, new_string_view_from_cstr("/api/v3"), &length, &value)
+                    && length == 4 && value == 10, "Expect '/api'.");
+        TEST_ASSERT(string_view_art_longest_prefix(&tree, new_string_view_from_cstr("/index.html"), &length, &value)
+                    && length == 1 && value == 0, "Expect '/'.");
+        TEST_ASSERT(!string_view_art_longest_prefix(&tree, new_string_view_from_cstr("api"), &length, &value),
+                    "Expect no route for a relative path.");
+
+        test_art_collector_t collector = { .count = 0 };
+        TEST_ASSERT(string_view_art_iterate_prefix(&tree, new_string_view_from_cstr("/api/v"), test_collect_art_key, &collector)
+                    && collector.count == 3, "Expect 3 routes under '/api/v'.");
+        TEST_ASSERT(strcmp(collector.keys[0], "/api/v1/") == 0 && strcmp(collector.keys[2], "/api/v2/") == 0,
+                    "Expect the routes in order.");
+        string_view_art_free(&tree);
+    }
+
+    TEST_CASE("Bulk load sorted keys into wide nodes"){
+        static char storage[300][2];
+        string_view_t keys[300];
+        uint64_t values[300];
+        string_view_art_t loaded, inserted;
+
+        /* Every first byte, then 44 second bytes under 'a', so the root and one child are wide nodes. */
+        for(size_t i = 0; i < 256; i++){
+            storage[i][0] = (char)i;
+            keys[i] = new_string_view(storage[i], 1);
+        }
+        for(size_t i = 0; i < 44; i++){
+            storage[256 + i][0] = 'a';
+            storage[256 + i][1] = (char)('0' + i);
+            keys[256 + i] = new_string_view(storage[256 + i], 2);
+        }
+        string_view_sort(keys, 300);
+        for(size_t i = 0; i < 300; i++) values[i] = i;
+
+        string_view_art_init(&loaded);
+        string_view_art_init(&inserted);
+        TEST_ASSERT(string_view_art_bulk_load(&loaded, keys, values, 300) && loaded.size == 300, "Expect 300 keys to be loaded.");
+        for(size_t i = 300; i > 0; i--) string_view_art_insert(&inserted, keys[i - 1], i - 1);
+
+        for(size_t i = 0; i < 300; i++){
+            uint64_t a = 0, b = 0;
+            TEST_CHECK(string_view_art_lookup(&loaded, keys[i], &a) && a == i, "Expect key %zu in the loaded tree.", i);
+            TEST_CHECK(string_view_art_lookup(&inserted, keys[i], &b) && b == i, "Expect key %zu in the inserted tree.", i);
+        }
+
+        string_view_art_free(&loaded);
+        string_view_art_init(&loaded);
+        keys[0] = keys[1];
+        TEST_ASSERT(!string_view_art_bulk_load(&loaded, keys, values, 300), "Expect duplicate keys to be rejected.");
+
+        string_view_art_free(&loaded);
+        string_view_art_free(&inserted);
+    }
+}
+
+TEST_SUITE(string_view_suffix_array) {
+
+    TEST_CASE("Answer substring queries"){
+        const string_view_t text = new_string_view_from_cstr("mississippi");
+        const uint32_t expected[] = { 10, 7, 4, 1, 0, 9, 8, 6, 3, 5, 2 };
+        const uint32_t expected_lcp[] = { 0, 1, 1, 4, 0, 0, 1, 0, 2, 1, 3 };
+        string_view_suffix_array_t index;
+        size_t positions[4] = { 0, 0, 0, 0 };
+
+        TEST_ASSERT(string_view_suffix_array_build(&index, text), "Expect the index to be built.");
+        TEST_ASSERT(memcmp(index.suffixes, expected, sizeof(expected)) == 0, "Expect the suffixes of 'mississippi' in order.");
+        TEST_ASSERT(memcmp(index.lcp, expected_lcp, sizeof(expected_lcp)) == 0, "Expect the LCP array.");
+
+        TEST_ASSERT(string_view_suffix_array_count(&index, new_string_view_from_cstr("issi")) == 2, "Expect 2 overlapping 'issi'.");
+        TEST_ASSERT(string_view_suffix_array_count(&index, new_string_view_from_cstr("s")) == 4, "Expect 4 's'.");
+        TEST_ASSERT(string_view_suffix_array_count(&index, new_string_view_from_cstr("ippix")) == 0, "Expect no 'ippix'.");
+        TEST_ASSERT(string_view_suffix_array_count(&index, STRING_VIEW_EMPTY) == 12, "Expect the empty pattern everywhere.");
+        TEST_ASSERT(string_view_suffix_array_contains(&index, new_string_view_from_cstr("mississippi")), "Expect the whole text.");
+        TEST_ASSERT(!string_view_suffix_array_contains(&index, new_string_view_from_cstr("mississippis")), "Expect no longer pattern.");
+        TEST_ASSERT(!string_view_suffix_array_contains(&index, new_string_view_from_cstr("pa")), "Expect no 'pa'.");
+
+        TEST_ASSERT(string_view_suffix_array_locate_all(&index, new_string_view_from_cstr("ssi"), positions, 4) == 2
+                    && positions[0] == 5 && positions[1] == 2, "Expect 'ssi' at 5 and 2, in suffix order.");
+        TEST_ASSERT(string_view_suffix_array_locate_all(&index, new_string_view_from_cstr("i"), positions, 1) == 4
+                    && positions[0] == 10, "Expect the total count with a short output array.");
+        string_view_suffix_array_free(&index);
+    }
+
+    TEST_CASE("Agree with a scan on repetitive text"){
+        static char data[4096];
+        string_view_suffix_array_t index;
+        uint32_t state = 12345;
+
+        /* A two-letter alphabet with long runs forces several levels of recursion. */
+        for(size_t i = 0; i < sizeof(data); i++){
+            state = state * 1103515245 + 12345;
+            data[i] = (i % 512 < 256) ? "ab"[(state >> 16) & 1] : "ab"[i & 1];
+        }
+        const string_view_t text = new_string_view(data, sizeof(data));
+
+        TEST_ASSERT(string_view_suffix_array_build(&index, text), "Expect the index to be built.");
+        for(size_t i = 1; i < text.count; i++){
+            const string_view_t previous = string_view_substr(text, index.suffixes[i - 1], STRING_VIEW_NPOS);
+            const string_view_t current = string_view_substr(text, index.suffixes[i], STRING_VIEW_NPOS);
+            size_t common = 0;
+            while(common < previous.count && common < current.count && previous.data[common] == current.data[common]) common++;
+            TEST_CHECK(string_view_compare(previous, current) < 0, "Expect suffix %zu after the previous one.", i);
+            TEST_CHECK(common == index.lcp[i], "Expect an LCP of %zu at rank %zu.", common, i);
+        }
+        for(size_t length = 1; length <= 12; length++){
+            const string_view_t pattern = string_view_substr(text, 700, length);
+            size_t expected = 0;
+            for(size_t i = 0; i + length <= text.count; i++){
+                expected += memcmp(&data[i], pattern.data, length) == 0;
+            }
+            TEST_CHECK(string_view_suffix_array_count(&index, pattern) == expected,
+                       "Expect %zu occurrences of the %zu-byte pattern.", expected, length);
+        }
+        string_view_suffix_array_free(&index);
+    }
+
+    TEST_CASE("Save and load an index"){
+        const string_view_t text = new_string_view_from_cstr("abracadabra");
+        string_view_suffix_array_t built, loaded, rejected;
+        size_t positions[2] = { 0, 0 };
+        bool same_arrays = false, located = false;
+        char path[512];
+
+        /* Everything runs before the first assertion, so the file and the indexes are released even when one fails. */
+        const bool created = test_create_temp_file(path, sizeof(path), "", 0);
+        const bool indexed = string_view_suffix_array_build(&built, text);
+        const bool saved = created && indexed && string_view_suffix_array_save(&built, path);
+
+        const bool same_text = saved && string_view_suffix_array_load(&loaded, path, text);
+        if(same_text){
+            same_arrays = memcmp(loaded.suffixes, built.suffixes, text.count * sizeof(uint32_t)) == 0
+                && memcmp(loaded.lcp, built.lcp, text.count * sizeof(uint32_t)) == 0;
+            located = string_view_suffix_array_locate_all(&loaded, new_string_view_from_cstr("abra"), positions, 2) == 2
+                && positions[0] == 7 && positions[1] == 0;
+            string_view_suffix_array_free(&loaded);
+        }
+
+        /* A failed load leaves the index empty, so freeing it is always safe. */
+        const bool other_text = saved && string_view_suffix_array_load(&rejected, path, new_string_view_from_cstr("abracadabrx"));
+        if(saved) string_view_suffix_array_free(&rejected);
+        const bool other_length = saved && string_view_suffix_array_load(&rejected, path, new_string_view_from_cstr("abra"));
+        if(saved) string_view_suffix_array_free(&rejected);
+
+        if(created) remove(path);
+        const bool missing = created && string_view_suffix_array_load(&rejected, path, text);
+        if(created) string_view_suffix_array_free(&rejected);
+        string_view_suffix_array_free(&built);
+
+        TEST_ASSERT(created, "Expect the test file to be created.");
+        TEST_ASSERT(indexed, "Expect the index to be built.");
+        TEST_ASSERT(saved, "Expect the index to be saved.");
+        TEST_ASSERT(same_text, "Expect the index to be loaded.");
+        TEST_ASSERT(same_arrays, "Expect the same arrays.");
+        TEST_ASSERT(located, "Expect 'abra' at 7 and 0.");
+        TEST_ASSERT(!other_text, "Expect a different text to be rejected.");
+        TEST_ASSERT(!other_length, "Expect a different length to be rejected.");
+        TEST_ASSERT(!missing, "Expect a missing file to fail.");
+    }
+}
+
+TEST_SUITE(string_view_edit_distance) {
+
+    TEST_CASE("Compute Levenshtein distances"){
+        const string_view_t kitten = new_string_view_from_cstr("kitten");
+        const string_view_t sitting = new_string_view_from_cstr("sitting");
+
+        TEST_ASSERT(string_view_edit_distance(kitten, sitting) == 3, "Expect 3 edits from 'kitten' to 'sitting'.");
+        TEST_ASSERT(string_view_edit_distance(sitting, kitten) == 3, "Expect the distance to be symmetric.");
+        TEST_ASSERT(string_view_edit_distance(kitten, kitten) == 0, "Expect no edit between equal views.");
+        TEST_ASSERT(string_view_edit_distance(STRING_VIEW_EMPTY, kitten) == 6, "Expect the length from an empty view.");
+        TEST_ASSERT(string_view_edit_distance(new_string_view_from_cstr("flaw"), new_string_view_from_cstr("lawn")) == 2,
+                    "Expect 2 edits from 'flaw' to 'lawn'.");
+
+        TEST_ASSERT(string_view_edit_distance_max(kitten, sitting, 3) == 3, "Expect the distance within the bound.");
+        TEST_ASSERT(string_view_edit_distance_max(kitten, sitting, 2) == 3, "Expect the bound plus one beyond it.");
+        TEST_ASSERT(string_view_edit_distance_max(kitten, new_string_view_from_cstr("kittens and cats"), 4) == 5,
+                    "Expect an early exit on lengths too far apart.");
+    }
+
+    TEST_CASE("Agree with the dynamic programming on long views"){
+        static char a[700], b[700];
+        static size_t row[701];
+        uint32_t state = 2024;
+
+        /* Lengths on both sides of the 64-byte word and the 512-byte stack limit. */
+        const size_t lengths[][2] = { { 64, 64 }, { 65, 100 }, { 200, 130 }, { 511, 513 }, { 600, 700 } };
+        for(size_t t = 0; t < sizeof(lengths) / sizeof(lengths[0]); t++){
+            const size_t n = lengths[t][0], m = lengths[t][1];
+            for(size_t i = 0; i < m; i++){
+                state = state * 1103515245 + 12345;
+                b[i] = (char)('a' + (state >> 16) % 4);
+                if(i < n) a[i] = ((state >> 20) % 3 != 0) ? b[i] : (char)('a' + (state >> 24) % 4);
+            }
+
+            for(size_t j = 0; j <= m; j++) row[j] = j;
+            for(size_t i = 1; i <= n; i++){
+                size_t diagonal = row[0];
+                row[0] = i;
+                for(size_t j = 1; j <= m; j++){
+                    const size_t above = row[j];
+                    size_t best = diagonal + (a[i - 1] != b[j - 1]);
+                    if(above + 1 < best) best = above + 1;
+                    if(row[j - 1] + 1 < best) best = row[j - 1] + 1;
+                    row[j] = best;
+                    diagonal = above;
+                }
+            }
+
+            TEST_CHECK(string_view_edit_distance(new_string_view(a, n), new_string_view(b, m)) == row[m],
+                       "Expect a distance of %zu between %zu and %zu bytes.", row[m], n, m);
+            TEST_CHECK(string_view_edit_distance_max(new_string_view(a, n), new_string_view(b, m), row[m] - 1) == row[m],
+                       "Expect the bound plus one between %zu and %zu bytes.", n, m);
+        }
+    }
+
+    TEST_CASE("Find approximate occurrences"){
+        const string_view_t text = new_string_view_from_cstr("the quick brown fox jumps over the lazy dog");
+        string_view_fuzzy_match_t match;
+
+        TEST_ASSERT(string_view_fuzzy_find(text, new_string_view_from_cstr("brwn"), 1, 0, &match) == 10
+                    && match.count == 5 && match.distance == 1, "Expect 'brown' for 'brwn'.");
+        TEST_ASSERT(string_view_fuzzy_find(text, new_string_view_from_cstr("jumps"), 0, 0, &match) == 20
+                    && match.count == 5 && match.distance == 0, "Expect an exact match with no edit allowed.");
+        TEST_ASSERT(string_view_fuzzy_find(text, new_string_view_from_cstr("lazzy"), 1, 0, &match) == 35
+                    && match.count == 4 && match.distance == 1, "Expect 'lazy' for 'lazzy'.");
+        TEST_ASSERT(string_view_fuzzy_find(text, new_string_view_from_cstr("thx"), 1, 1, &match) == 31
+                    && match.count == 2 && match.distance == 1, "Expect the second 'th' from index 1.");
+        TEST_ASSERT(string_view_fuzzy_find(text, new_string_view_from_cstr("zebra"), 2, 0, NULL) == STRING_VIEW_NPOS,
+                    "Expect no match for 'zebra'.");
+    }
+}
+
 int main(void){
 
     REGISTER_AND_RUN_SUITE(string_view_creation);
@@ -325,6 +2131,31 @@ int main(void){
     REGISTER_AND_RUN_SUITE(string_view_comparison);
     REGISTER_AND_RUN_SUITE(string_view_prefix_suffix);
     REGISTER_AND_RUN_SUITE(string_view_utils);
+    REGISTER_AND_RUN_SUITE(string_view_simd);
+    REGISTER_AND_RUN_SUITE(string_view_searcher);
+    REGISTER_AND_RUN_SUITE(string_view_automaton);
+    REGISTER_AND_RUN_SUITE(string_view_split);
+    REGISTER_AND_RUN_SUITE(string_view_lines);
+    REGISTER_AND_RUN_SUITE(string_view_reader);
+    REGISTER_AND_RUN_SUITE(string_view_hashing);
+    REGISTER_AND_RUN_SUITE(string_view_map);
+    REGISTER_AND_RUN_SUITE(string_view_intern);
+    REGISTER_AND_RUN_SUITE(string_view_arena);
+    REGISTER_AND_RUN_SUITE(string_builder);
+    REGISTER_AND_RUN_SUITE(string_view_parsing);
+    REGISTER_AND_RUN_SUITE(string_view_charset);
+    REGISTER_AND_RUN_SUITE(string_view_ordering);
+    REGISTER_AND_RUN_SUITE(string_view_prefixed);
+    REGISTER_AND_RUN_SUITE(string_view_parallel);
+    REGISTER_AND_RUN_SUITE(string_view_counting);
+    REGISTER_AND_RUN_SUITE(string_view_utf8);
+    REGISTER_AND_RUN_SUITE(string_view_csv);
+    REGISTER_AND_RUN_SUITE(string_view_http);
+    REGISTER_AND_RUN_SUITE(string_view_case_insensitive);
+    REGISTER_AND_RUN_SUITE(string_view_perfect_hash);
+    REGISTER_AND_RUN_SUITE(string_view_radix_tree);
+    REGISTER_AND_RUN_SUITE(string_view_suffix_array);
+    REGISTER_AND_RUN_SUITE(string_view_edit_distance);
 
     PRINT_TEST_RESULT();
 
@@ -30,6 +30,24 @@ static int __test_failed = 0;
         continue;                                                       \
     }                                                                   \
 
+/* Like TEST_ASSERT, but the case keeps running, so it can be used inside loops. The message
+   takes printf arguments to name the failing input; only the first failure of a case is printed. */
+#define TEST_CHECK(expression, ...)                                     \
+    if(!(expression) && __passed) {                                     \
+        fprintf(stdout, "\n\e[0;31m[%s, Ln: %d] Assertion failed: %s\n\tMessage: \'", \
+                __func__, __LINE__, #expression);                       \
+        fprintf(stdout, __VA_ARGS__);                                   \
+        fprintf(stdout, "\'\n\e[0m");                                   \
+        __passed = 0;                                                   \
+    }                                                                   \
+
+/* Runs the statement once per SIMD level supported by the CPU, from the scalar code up,
+   then restores the best level. */
+#define FOR_EACH_SIMD_LEVEL(level)                                      \
+    for(string_view_simd_t __best = string_view_simd_level(), level = STRING_VIEW_SIMD_SCALAR; \
+        (level <= __best) ? (string_view_set_simd_level(level), 1) : (string_view_set_simd_level(__best), 0); \
+        level = (string_view_simd_t)(level + 1))
+
 #define TEST_PASSED_COUNT() (__test_passed)
 #define TEST_FAILED_COUNT() (__test_failed)
 